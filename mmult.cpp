@@ -1,20 +1,42 @@
 // ********** INCLUDES ********** //
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <fstream>
 #include <functional>
 #include <iomanip>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
 #include <random>
+#include <set>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <vector>
 #include <utility>
+#include <cctype>
 #include <cstdlib>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 #include <boost/program_options.hpp>
 #define BOOST_DISABLE_ASSERTS 1
@@ -24,7 +46,49 @@
 
 uint32_t TRIALS {5};
 uint32_t SEED {0};
+uint32_t CUTOFF {64};
+int32_t MIN_VALUE {0};
+int32_t MAX_VALUE {4};
+uint32_t THREADS {std::max (std::thread::hardware_concurrency(), 1u)};
+uint32_t PARALLEL_DEPTH {2};
+std::map <std::string, std::pair <double, std::uint32_t>> TRIAL_STATS;
 const uint32_t CHECKSUM_MAX {10000};
+const uint32_t DIGEST_CHUNK {1 << 16};
+const uint32_t DIGEST_PARALLEL_MIN {1 << 18};
+bool DIGEST {false};
+std::string GOLDEN_CACHE;
+std::string EPILOGUE {"bias-relu"};
+const int32_t CLAMP_MIN {0};
+const int32_t CLAMP_MAX {63};
+const int32_t REQUANTIZE_MULTIPLIER {77};
+const uint32_t REQUANTIZE_SHIFT {8};
+const uint32_t CHAIN_PANEL_BYTES {256 * 1024};
+uint32_t CHAIN_PANEL {0};
+std::string SPLITK_REDUCE {"tree"};
+std::string SCHEDULE {"static"};
+uint32_t CHUNK {1};
+uint32_t OZAKI_SLICES {4};
+const uint32_t OZAKI_SLICE_BITS {7};
+uint32_t INJECT_FAULTS {0};
+uint32_t APPROX_RANK {0};
+double EPSILON {0.1};
+std::vector <std::uint32_t> DELTAS {1, 4, 16, 64};
+std::string STREAM_A;
+std::string STREAM_C;
+uint32_t STREAM_PANEL {64};
+const uint32_t STREAM_BUFFERS {2};
+std::string OUTPUT_C;
+std::string LOAD_A;
+const uint32_t PACK_PANEL_BYTES {256 * 1024};
+std::string ROUNDING {"half-up"};
+bool WRAP {false};
+uint32_t TINY_SIZE {4};
+const uint32_t BATCH_LANES {8};
+uint32_t BATCH_COUNT {64};
+std::string BATCH_SHAPES {"uniform"};
+bool MIRROR {false};
+uint32_t FACTOR_BLOCK {64};
+std::string LOAD_B;
 std::fstream EMPTY_STREAM {"/dev/null"};
 
 // ********** CONSTEXPR UTILITIES ********** //
@@ -49,15 +113,606 @@ public:
 using ValueType = int;
 using Matrix2x2 = boost::multi_array <ValueType, 2>;
 
+using WideType = __int128;
+
 using EngineType = std::mt19937_64;
 using DistributionType = std::uniform_int_distribution <ValueType>;
 using GeneratorType = std::function <ValueType()>;
 
 using ResultKeyType = std::pair <std::uint32_t, std::string>;
-using ResultValueType = std::pair <float, ValueType>;
+using ResultValueType = std::tuple <float, ValueType, std::uint64_t>;
 using ResultsType = std::map <ResultKeyType, ResultValueType>;
+using StatsType = std::map <std::string, std::map <ResultKeyType, double>>;
 using FunctionType = std::function <std::uint64_t (const Matrix2x2 &, const Matrix2x2 &, Matrix2x2 &, const std::uint32_t N)>;
 
+// ********** THREAD POOL ********** //
+
+// Work-stealing pool: every worker owns a deque, runs its newest task first and
+// steals the oldest task of another worker when its own deque is empty. The
+// thread that creates the pool is worker 0 and runs tasks while it waits.
+class ThreadPool {
+	using Task = std::function <void()>;
+
+	struct Queue {
+		std::mutex lock;
+		std::deque <Task> tasks;
+	};
+
+	std::vector <std::unique_ptr <Queue>> queues;
+	std::vector <std::thread> workers;
+	std::atomic <bool> done {false};
+	std::atomic <std::uint32_t> queued {0};
+	std::mutex sleepLock;
+	std::condition_variable wake;
+
+public:
+	explicit ThreadPool (std::uint32_t threads) : queues (threads) {
+		for (auto & queue : queues)
+			queue.reset (new Queue);
+		for (std::uint32_t id{1}; id < threads; ++id)
+			workers.emplace_back ([this, id] {
+				index() = id;
+				while (!done)
+					if (!runOne()) {
+						std::unique_lock <std::mutex> guard {sleepLock};
+						wake.wait (guard, [this] { return done || queued > 0; });
+					}
+			});
+	}
+
+	~ThreadPool () {
+		{
+			std::lock_guard <std::mutex> guard {sleepLock};
+			done = true;
+		}
+		wake.notify_all();
+		for (auto & worker : workers)
+			worker.join();
+	}
+
+	std::uint32_t size () const {
+		return queues.size();
+	}
+
+	void submit (Task task) {
+		{
+			Queue & queue = *queues[index()];
+			std::lock_guard <std::mutex> guard {queue.lock};
+			queue.tasks.push_back (std::move (task));
+		}
+		{
+			std::lock_guard <std::mutex> guard {sleepLock};
+			++queued;
+		}
+		wake.notify_one();
+	}
+
+	// Runs one task (own newest, else stolen oldest); false if none was found
+	bool runOne () {
+		Task task;
+		for (std::uint32_t offset{0}; offset < size() && !task; ++offset) {
+			Queue & queue = *queues[(index() + offset) % size()];
+			std::lock_guard <std::mutex> guard {queue.lock};
+			if (queue.tasks.empty())
+				continue;
+			if (offset == 0) {
+				task = std::move (queue.tasks.back());
+				queue.tasks.pop_back();
+			} else {
+				task = std::move (queue.tasks.front());
+				queue.tasks.pop_front();
+			}
+			--queued;
+		}
+		if (!task)
+			return false;
+		task();
+		return true;
+	}
+
+	// Index of the calling worker (0 for any thread outside the pool)
+	static std::uint32_t & index () {
+		static thread_local std::uint32_t id {0};
+		return id;
+	}
+};
+
+// A set of tasks that can be waited on; waiting threads help run pool tasks
+class TaskGroup {
+	ThreadPool & pool;
+	std::atomic <std::uint32_t> pending {0};
+
+public:
+	explicit TaskGroup (ThreadPool & pool) : pool (pool) {}
+
+	~TaskGroup () {
+		wait();
+	}
+
+	void run (std::function <void()> task) {
+		++pending;
+		pool.submit ([this, task] {
+			task();
+			--pending;
+		});
+	}
+
+	void wait () {
+		while (pending > 0)
+			if (!pool.runOne())
+				std::this_thread::yield();
+	}
+};
+
+// Tasks with dependencies: a task is submitted to the pool once every task it
+// depends on has finished
+class TaskGraph {
+	struct Node {
+		std::function <void()> work;
+		std::vector <std::uint32_t> successors;
+		std::atomic <std::uint32_t> pending {0};
+	};
+
+	std::deque <Node> nodes;
+
+	void launch (TaskGroup & group, std::uint32_t id) {
+		group.run ([this, &group, id] {
+			nodes[id].work();
+			for (std::uint32_t successor : nodes[id].successors)
+				if (--nodes[successor].pending == 0)
+					launch (group, successor);
+		});
+	}
+
+public:
+	// Adds a task after its dependencies (ids returned by earlier calls)
+	std::uint32_t add (std::function <void()> work, const std::vector <std::uint32_t> & dependencies) {
+		const std::uint32_t id = nodes.size();
+		nodes.emplace_back();
+		nodes.back().work = std::move (work);
+		for (std::uint32_t dependency : std::set <std::uint32_t> (std::begin (dependencies), std::end (dependencies))) {
+			nodes[dependency].successors.push_back (id);
+			++nodes.back().pending;
+		}
+		return id;
+	}
+
+	void run (ThreadPool & pool) {
+		std::vector <std::uint32_t> roots;
+		for (std::uint32_t id{0}; id < nodes.size(); ++id)
+			if (nodes[id].pending == 0)
+				roots.push_back (id);
+		TaskGroup group {pool};
+		for (std::uint32_t id : roots)
+			launch (group, id);
+		group.wait();
+	}
+};
+
+// Distribution of loop iterations over workers: one contiguous block each,
+// chunks dealt round-robin, chunks claimed from a shared atomic counter, or
+// claims that shrink with the remaining work but never below the chunk size
+enum class Schedule {
+	STATIC,
+	CYCLIC,
+	DYNAMIC,
+	GUIDED
+};
+
+const std::map <std::string, Schedule> SCHEDULES {
+	{ "static", Schedule::STATIC },
+	{ "cyclic", Schedule::CYCLIC },
+	{ "dynamic", Schedule::DYNAMIC },
+	{ "guided", Schedule::GUIDED }
+};
+
+// ********** FIXED POINT ********** //
+
+// Q15 and Q31 operands, both with a Q31 Output. Products drop ROUNDED bits
+// (Q15 x Q15 products are exact Q30 values, Q31 x Q31 products are rounded
+// back to Q31), are summed exactly in Acc, then shifted left by WIDEN bits and
+// saturated (or wrapped) to Output once at the end
+struct Q15 {
+	using Input = std::int16_t;
+	using Product = std::int32_t;
+	using Acc = std::int64_t;
+	using Output = std::int32_t;
+	static const std::uint32_t ROUNDED {0};
+	static const std::uint32_t WIDEN {1};
+};
+
+struct Q31 {
+	using Input = std::int32_t;
+	using Product = std::int64_t;
+	using Acc = std::int64_t;
+	using Output = std::int32_t;
+	static const std::uint32_t ROUNDED {31};
+	static const std::uint32_t WIDEN {0};
+};
+
+// Rounding of a product shifted right by ROUNDED bits: toward minus infinity,
+// halves up, or halves to even
+enum class Rounding {
+	TRUNCATE,
+	HALF_UP,
+	CONVERGENT
+};
+
+const std::map <std::string, Rounding> ROUNDINGS {
+	{ "truncate", Rounding::TRUNCATE },
+	{ "half-up", Rounding::HALF_UP },
+	{ "convergent", Rounding::CONVERGENT }
+};
+
+// ********** EPILOGUES ********** //
+
+// Element-wise operations on finished elements of C, given the column index
+
+struct NoEpilogue {
+	static const bool ENABLED {false};
+
+	ValueType operator() (ValueType c, std::uint32_t) const {
+		return c;
+	}
+};
+
+struct BiasReluEpilogue {
+	static const bool ENABLED {true};
+	const ValueType * bias;
+
+	ValueType operator() (ValueType c, std::uint32_t j) const {
+		return std::max (c + bias[j], 0);
+	}
+};
+
+struct ClampEpilogue {
+	static const bool ENABLED {true};
+	ValueType lo, hi;
+
+	ValueType operator() (ValueType c, std::uint32_t) const {
+		return std::min (std::max (c, lo), hi);
+	}
+};
+
+// Adds the bias, scales by multiplier / 2^shift (rounding half up) and
+// saturates to int8
+struct RequantizeEpilogue {
+	static const bool ENABLED {true};
+	const ValueType * bias;
+	std::int32_t multiplier;
+	std::uint32_t shift;
+
+	ValueType operator() (ValueType c, std::uint32_t j) const {
+		const std::int64_t scaled {(std::int64_t {c + bias[j]} * multiplier + (std::int64_t {1} << (shift - 1))) >> shift};
+		return static_cast <ValueType> (std::min <std::int64_t> (std::max <std::int64_t> (scaled, -128), 127));
+	}
+};
+
+// ********** ARENA ********** //
+
+// Bump-pointer arena with mark/release (stack) discipline for recursive
+// workspaces. reserve() sizes the first chunk up front; requests past the end
+// spill into further chunks, which are kept for reuse after a release.
+class Arena {
+	static const std::size_t ALIGNMENT {64 / sizeof (ValueType)};
+
+	std::vector <std::vector <ValueType>> chunks;
+	std::size_t chunk {0}, top {0}, used {0};
+	std::atomic <std::size_t> highWater {0};
+
+	// Never destroyed: pool workers still unregister their arenas while
+	// static destructors run at exit
+	static std::mutex & registryLock () {
+		static std::mutex * lock {new std::mutex};
+		return *lock;
+	}
+
+	static std::vector <Arena *> & registry () {
+		static std::vector <Arena *> * arenas {new std::vector <Arena *>};
+		return *arenas;
+	}
+
+public:
+	struct Mark {
+		std::size_t chunk, top, used;
+	};
+
+	Arena () {
+		std::lock_guard <std::mutex> guard {registryLock()};
+		registry().push_back (this);
+	}
+
+	~Arena () {
+		std::lock_guard <std::mutex> guard {registryLock()};
+		registry().erase (std::find (std::begin (registry()), std::end (registry()), this));
+	}
+
+	// Elements an allocation of n elements occupies, padded to a cache line
+	static std::size_t footprint (std::size_t n) {
+		return (n + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+	}
+
+	void reserve (std::size_t n) {
+		if (used == 0 && (chunks.empty() || chunks[0].size() < n)) {
+			chunks.clear();
+			chunks.emplace_back (footprint (n));
+			chunk = top = 0;
+		}
+	}
+
+	ValueType * allocate (std::size_t n) {
+		n = footprint (n);
+		if (chunks.empty())
+			chunks.emplace_back (n);
+		if (chunks[chunk].size() - top < n) {
+			if (chunk + 1 < chunks.size() && chunks[chunk + 1].size() < n)
+				chunks.erase (std::begin (chunks) + chunk + 1, std::end (chunks));
+			if (chunk + 1 == chunks.size())
+				chunks.emplace_back (std::max (n, chunks[chunk].size()));
+			++chunk;
+			top = 0;
+		}
+		ValueType * block {chunks[chunk].data() + top};
+		top += n;
+		used += n;
+		if (used > highWater)
+			highWater = used;
+		return block;
+	}
+
+	ValueType * allocateZeroed (std::size_t n) {
+		ValueType * block {allocate (n)};
+		std::fill_n (block, n, 0);
+		return block;
+	}
+
+	Mark mark () const {
+		return { chunk, top, used };
+	}
+
+	void release (const Mark & m) {
+		chunk = m.chunk;
+		top = m.top;
+		used = m.used;
+	}
+
+	// Sum of the high-water marks (in elements) of every live arena
+	static std::size_t totalHighWater () {
+		std::lock_guard <std::mutex> guard {registryLock()};
+		std::size_t total {0};
+		for (Arena * arena : registry())
+			total += arena->highWater;
+		return total;
+	}
+
+	static void resetHighWater () {
+		std::lock_guard <std::mutex> guard {registryLock()};
+		for (Arena * arena : registry())
+			arena->highWater = arena->used;
+	}
+};
+
+// Releases everything allocated from an arena during its lifetime
+class ArenaScope {
+	Arena & arena;
+	const Arena::Mark mark;
+
+public:
+	explicit ArenaScope (Arena & arena) : arena (arena), mark (arena.mark()) {}
+
+	~ArenaScope () {
+		arena.release (mark);
+	}
+};
+
+// ********** CHANNELS ********** //
+
+// Bounded blocking queue between the stages of a pipeline; pop fails once the
+// channel is closed and drained
+template <typename T>
+class Channel {
+	std::mutex lock;
+	std::condition_variable changed;
+	std::deque <T> items;
+	const std::size_t capacity;
+	bool closed {false};
+
+public:
+	explicit Channel (std::size_t capacity) : capacity (capacity) {}
+
+	void push (T item) {
+		std::unique_lock <std::mutex> guard {lock};
+		changed.wait (guard, [this] { return items.size() < capacity; });
+		items.push_back (std::move (item));
+		changed.notify_all();
+	}
+
+	bool pop (T & item) {
+		std::unique_lock <std::mutex> guard {lock};
+		changed.wait (guard, [this] { return !items.empty() || closed; });
+		if (items.empty())
+			return false;
+		item = std::move (items.front());
+		items.pop_front();
+		changed.notify_all();
+		return true;
+	}
+
+	void close () {
+		std::lock_guard <std::mutex> guard {lock};
+		closed = true;
+		changed.notify_all();
+	}
+};
+
+// Writes panels of rows to a file from a writer thread, so that the producer
+// only blocks once every buffer is in flight. Panels are written in order with
+// pwrite at their offsets, or with write where the file cannot seek. Buffers
+// handed over are returned to the pool of spares once written; borrowed rows
+// must stay unchanged until finish().
+class PanelWriter {
+	using Clock = std::chrono::high_resolution_clock;
+
+	struct Job {
+		std::vector <ValueType> buffer;
+		const void * data;
+		std::size_t bytes;
+		off_t offset;
+	};
+
+	int fd;
+	off_t offset;
+	bool seekable;
+	Channel <Job> pending;
+	Channel <std::vector <ValueType>> spares;
+	Clock::duration busy {0};
+	std::string error;
+	std::thread worker;
+
+	void writeJob (const Job & job) {
+		for (std::size_t done{0}; done < job.bytes;) {
+			const char * data {static_cast <const char *> (job.data) + done};
+			const ssize_t put {seekable ? ::pwrite (fd, data, job.bytes - done, job.offset + done) : ::write (fd, data, job.bytes - done)};
+			if (put < 0 && errno != EINTR)
+				throw std::runtime_error (std::string {"output write failed: "} + std::strerror (errno));
+			done += std::max <ssize_t> (put, 0);
+		}
+	}
+
+public:
+	PanelWriter (int fd, std::uint32_t buffers, std::size_t elements) :
+		fd (fd), offset (::lseek (fd, 0, SEEK_CUR)), seekable (offset >= 0), pending (std::max (buffers, 1u)), spares (std::max (buffers, 1u)) {
+		for (std::uint32_t buffer{0}; buffer < buffers; ++buffer)
+			spares.push (std::vector <ValueType> (elements));
+		worker = std::thread {[this] {
+			Job job;
+			while (pending.pop (job)) {
+				auto startTime = Clock::now();
+				try {
+					if (error.empty())
+						writeJob (job);
+				} catch (std::runtime_error & ex) {
+					error = ex.what();
+				}
+				busy += Clock::now() - startTime;
+				if (!job.buffer.empty())
+					spares.push (std::move (job.buffer));
+			}
+		}};
+	}
+
+	// Drains without reporting: a failed write surfaces from finish() only
+	~PanelWriter () {
+		if (worker.joinable()) {
+			pending.close();
+			worker.join();
+		}
+	}
+
+	// A spare buffer, waiting for one to be written if all are in flight
+	std::vector <ValueType> acquire () {
+		std::vector <ValueType> buffer;
+		spares.pop (buffer);
+		return buffer;
+	}
+
+	// Writes the first bytes of an acquired buffer, which returns to the spares
+	void write (std::vector <ValueType> buffer, std::size_t bytes) {
+		const void * data {buffer.data()};
+		pending.push (Job {std::move (buffer), data, bytes, offset});
+		offset += bytes;
+	}
+
+	// Writes borrowed rows
+	void write (const void * data, std::size_t bytes) {
+		pending.push (Job {{}, data, bytes, offset});
+		offset += bytes;
+	}
+
+	// Waits until everything is written and leaves the file offset past the
+	// panels, since pwrite does not move it; throws if a write failed
+	void finish () {
+		pending.close();
+		worker.join();
+		if (!error.empty())
+			throw std::runtime_error (error);
+		if (seekable && ::lseek (fd, offset, SEEK_SET) < 0)
+			throw std::runtime_error (std::string {"output seek failed: "} + std::strerror (errno));
+	}
+
+	// Time the writer thread spent writing
+	Clock::duration busyTime () const {
+		return busy;
+	}
+};
+
+// ********** BILINEAR SCHEMES ********** //
+
+// A bilinear <m,k,n:r> algorithm for C (m x n blocks) = A (m x k) * B (k x n).
+// Each of the r rows of the table holds the coefficients of the blocks of A (U)
+// and B (V) forming one product, followed by its coefficients in each block of
+// C (W). Blocks are numbered row-major.
+struct BilinearScheme {
+	std::uint32_t m, k, n, r;
+	std::vector <int> table;
+
+	std::uint32_t width () const {
+		return m * k + k * n + m * n;
+	}
+
+	const int * u (std::uint32_t p) const {
+		return table.data() + p * width();
+	}
+
+	const int * v (std::uint32_t p) const {
+		return u (p) + m * k;
+	}
+
+	const int * w (std::uint32_t p) const {
+		return v (p) + k * n;
+	}
+};
+
+extern const BilinearScheme STRASSEN;
+extern const BilinearScheme LADERMAN;
+extern const BilinearScheme STRASSEN_223;
+
+// ********** GOLDEN RESULTS ********** //
+
+// Reference product summary: a digest of C to verify against, plus row and
+// column sums (exact in 64 bits) to locate a mismatch
+struct GoldenResult {
+	std::uint64_t digest;
+	std::vector <std::int64_t> rowSums, colSums;
+};
+
+// Compressed sparse rows: the entries of row r are columns/values
+// [rowStart[r], rowStart[r + 1])
+struct SparseMatrix {
+	std::uint32_t rows, cols;
+	std::vector <std::uint32_t> rowStart, columns;
+	std::vector <ValueType> values;
+};
+
+// Matrix stored as bits-wide codes above offset, bits a power of two so no code
+// straddles a word; every row starts on a word
+struct BitPackedMatrix {
+	std::uint32_t rows, cols, bits, wordsPerRow;
+	ValueType offset;
+	std::vector <std::uint64_t> words;
+};
+
+// One product C (M x N) += A (M x K) * B (K x N) of a grouped batch, on strided storage
+struct GemmProblem {
+	std::uint32_t M, K, N;
+	const ValueType * A;
+	std::uint32_t lda;
+	const ValueType * B;
+	std::uint32_t ldb;
+	ValueType * C;
+	std::uint32_t ldc;
+};
+
 // ********** FORWARD FUNCTION DECLARATIONS ********** //
 
 // Prints to passed ostream if flag evaluates to true
@@ -71,8 +726,175 @@ std::string print (const std::string &, std::vector <std::string> &, std::vector
 template <char L1, char L2, char L3>
 std::uint64_t multiply (const Matrix2x2 &, const Matrix2x2 &, Matrix2x2 &, const std::uint32_t);
 
+// Applies an epilogue to C[rowLo, rowHi) x [colLo, colHi)
+template <typename Epilogue>
+void applyEpilogue (Matrix2x2 &, std::uint32_t, std::uint32_t, std::uint32_t, std::uint32_t, const Epilogue &);
+
+// Matrix Multiplication followed by EPILOGUE, fused into the traversal or as a separate pass over C
+template <char L1, char L2, char L3, bool Fused>
+std::uint64_t multiplyEpilogue (const Matrix2x2 &, const Matrix2x2 &, Matrix2x2 &, const std::uint32_t);
+
+// Chain product C = (A * B) * E, E generated from SEED + 1. Fused, row panels of
+// A * B are multiplied by E while they are in cache instead of materializing A * B.
+template <bool Fused>
+std::uint64_t multiplyChain (const Matrix2x2 &, const Matrix2x2 &, Matrix2x2 &, const std::uint32_t);
+
+// Split-K Matrix Multiplication: every worker computes a partial C over a slice
+// of k, and the partials are combined with the SPLITK_REDUCE strategy
+std::uint64_t multiplySplitK (const Matrix2x2 &, const Matrix2x2 &, Matrix2x2 &, const std::uint32_t);
+
+// Bits of the narrowest accumulator (16, 32, 64 or 128) that provably holds every
+// element of A and B and every sum of K products, given the value ranges
+std::uint32_t accumulatorBits (std::int64_t, std::int64_t, std::int64_t, std::int64_t, std::uint32_t);
+
+// ikj Matrix Multiplication in the accumulator width chosen from a scan of A and B
+std::uint64_t multiplyAutoWidth (const Matrix2x2 &, const Matrix2x2 &, Matrix2x2 &, const std::uint32_t);
+
+// ikj Matrix Multiplication accumulating in T
+template <typename T>
+std::uint64_t multiplyFixedWidth (const Matrix2x2 &, const Matrix2x2 &, Matrix2x2 &, const std::uint32_t);
+
+// Exact Matrix Multiplication modulo CRT_PRIMES (one task per prime), combined
+// with the Chinese Remainder Theorem into WideType
+std::uint64_t multiplyCRT (const Matrix2x2 &, const Matrix2x2 &, Matrix2x2 &, const std::uint32_t);
+
+// ikj Matrix Multiplication of the fp64 operands in double
+std::uint64_t multiplyDouble (const Matrix2x2 &, const Matrix2x2 &, Matrix2x2 &, const std::uint32_t);
+
+// fp64 Matrix Multiplication emulated with OZAKI_SLICES int8 slices per operand
+std::uint64_t multiplyOzaki (const Matrix2x2 &, const Matrix2x2 &, Matrix2x2 &, const std::uint32_t);
+
+// Algorithm-based fault tolerance: multiplies A with a column-checksum row by B
+// with a row-checksum column using kernel, then locates and corrects a single
+// corrupted element of C from the mismatching row and column checksums
+std::uint64_t multiplyABFT (const FunctionType &, const Matrix2x2 &, const Matrix2x2 &, Matrix2x2 &, const std::uint32_t);
+
+// Approximate Matrix Multiplication from rank outer products A[:,k] B[k,:]
+// sampled with probability proportional to |A[:,k]| |B[k,:]|
+std::uint64_t multiplySampled (const Matrix2x2 &, const Matrix2x2 &, Matrix2x2 &, const std::uint32_t);
+
+// Approximate Matrix Multiplication (A S^T) (S B) with a rank x N CountSketch S
+std::uint64_t multiplySketched (const Matrix2x2 &, const Matrix2x2 &, Matrix2x2 &, const std::uint32_t);
+
+// Changes to A (and B) that a previous C = A * B is updated for
+enum class Update {
+	RANK,	// A += U V with U N x d, V d x N
+	ROWS,	// d rows of A replaced
+	APPEND	// d rows appended to A and d columns to B
+};
+
+// Updates A * B for every size in DELTAS and compares against recomputing the
+// product; returns the total update time
+std::uint64_t multiplyIncremental (Update, const Matrix2x2 &, const Matrix2x2 &, Matrix2x2 &, const std::uint32_t);
+
+// Streams row panels of STREAM_A (or of A) through a reader thread, multiplies
+// each by B while the next one loads and writes the rows of C to STREAM_C;
+// C receives the first N rows
+std::uint64_t multiplyStream (const Matrix2x2 &, const Matrix2x2 &, Matrix2x2 &, const std::uint32_t);
+
+// ikj Matrix Multiplication in panels of STREAM_PANEL rows, each handed to a
+// writer thread for OUTPUT_C while the next one is computed
+std::uint64_t multiplyOutput (const Matrix2x2 &, const Matrix2x2 &, Matrix2x2 &, const std::uint32_t);
+
+// ikj Matrix Multiplication over panels of B sized to PACK_PANEL_BYTES, with
+// A and B read from bit-packed storage and decompressed while the panels are
+// packed, or (Packed false) copied from the plain storage
+template <bool Packed>
+std::uint64_t multiplyPanels (const Matrix2x2 &, const Matrix2x2 &, Matrix2x2 &, const std::uint32_t);
+
+// Quantized Matrix Multiplications of int8 B (A and B clamped to int8) with
+// A as int8, as packed int4 pairs along k, or pruned to 2:4 structured sparsity
+// (two values and their 2-bit indices per four); AVX2 when Simd and available,
+// otherwise the scalar reference
+template <bool Simd>
+std::uint64_t multiplyInt8 (const Matrix2x2 &, const Matrix2x2 &, Matrix2x2 &, const std::uint32_t);
+template <bool Simd>
+std::uint64_t multiplyInt4 (const Matrix2x2 &, const Matrix2x2 &, Matrix2x2 &, const std::uint32_t);
+template <bool Simd>
+std::uint64_t multiplySparse24 (const Matrix2x2 &, const Matrix2x2 &, Matrix2x2 &, const std::uint32_t);
+
+// Fixed-point Matrix Multiplication of Q operands derived from SEED + 6 with
+// ROUNDING and saturation (unless WRAP), checked against a scalar reference
+template <char L1, char L2, char L3, typename Q>
+std::uint64_t multiplyFixed (const Matrix2x2 &, const Matrix2x2 &, Matrix2x2 &, const std::uint32_t);
+
+// Batched products of the TINY_SIZE blocks of A and B (block (r, c) of C is
+// block (r, c) of A times block (r, c) of B), one matrix at a time from the
+// contiguous batch, or BATCH_LANES matrices at a time from the interleaved one
+template <bool Interleaved>
+std::uint64_t multiplyBatch (const Matrix2x2 &, const Matrix2x2 &, Matrix2x2 &, const std::uint32_t);
+
+// Computes a batch of products of any shapes: sorted by cost, small ones binned
+// together and large ones split into row tiles of similar cost, run as tasks
+// on the work-stealing pool
+void groupedMultiply (const std::vector <GemmProblem> &);
+
+// A batch of BATCH_COUNT problems on blocks of A and B with BATCH_SHAPES
+// dimensions, through groupedMultiply or (Grouped false) one parallel multiply
+// per problem; every result is added into the top-left corner of C
+template <bool Grouped>
+std::uint64_t multiplyGrouped (const Matrix2x2 &, const Matrix2x2 &, Matrix2x2 &, const std::uint32_t);
+
+// Symmetric rank-k update: the lower triangle of C = A * A^T (and the upper
+// one too when MIRROR), over panels of A^T; rows split across the pool when parallel
+template <bool Parallel>
+std::uint64_t multiplySyrk (const Matrix2x2 &, const Matrix2x2 &, Matrix2x2 &, const std::uint32_t);
+
+// Right-looking blocked LU with partial pivoting (Cholesky false) or Cholesky
+// of a double matrix derived from A, tiled by FACTOR_BLOCK, with the trailing
+// updates done by the L1 L2 L3 traversal as tasks of a tile DAG
+template <char L1, char L2, char L3, bool Cholesky>
+std::uint64_t factorize (const Matrix2x2 &, const Matrix2x2 &, Matrix2x2 &, const std::uint32_t);
+
+// Parallel Matrix Multiplication (rows or columns split across the pool)
+template <char L1, char L2, char L3>
+std::uint64_t multiplyParallel (const Matrix2x2 &, const Matrix2x2 &, Matrix2x2 &, const std::uint32_t);
+
+// Fast matrix multiplication with a bilinear scheme, recursing down to CUTOFF;
+// the products of the first PARALLEL_DEPTH levels run as tasks when parallel
+std::uint64_t multiplyBilinear (const BilinearScheme &, bool, const Matrix2x2 &, const Matrix2x2 &, Matrix2x2 &, const std::uint32_t);
+
+// Shared pool of THREADS workers, created on first use
+ThreadPool & threadPool ();
+
+// Runs body (begin, end) over [0, count) on every worker with the given schedule
+// and chunk size; returns the load imbalance (slowest / mean worker busy time)
+double parallelFor (std::uint32_t, const std::function <void (std::uint32_t, std::uint32_t)> &, Schedule = Schedule::STATIC, std::uint32_t = 1);
+
+// Workspace arena of the calling thread
+Arena & threadArena ();
+
+// Records a per-trial statistic of the running kernel (averaged over trials)
+void reportStat (const std::string &, double);
+
+// Checks that a bilinear scheme satisfies the Brent equations
+bool validScheme (const BilinearScheme &);
+
+// XXH64 of a byte range
+std::uint64_t xxh64 (const void *, std::size_t, std::uint64_t);
+
+// Digest of every element of a matrix, hashed in parallel chunks
+std::uint64_t matrixDigest (const Matrix2x2 &);
+
+// Formats a digest as 16 hexadecimal digits
+std::string toHex (std::uint64_t);
+
+// Summarizes a product for the golden-result cache
+GoldenResult summarize (const Matrix2x2 &);
+
+// Loads the reference result for a cache key from GOLDEN_CACHE, computing and
+// storing it with the reference (ikj) kernel on a miss
+GoldenResult goldenResult (const std::string &, const Matrix2x2 &, const Matrix2x2 &, const std::uint32_t);
+
+// Compares C against a reference in O(N^2); "ok" or the first mismatch found
+std::string verify (const GoldenResult &, const Matrix2x2 &);
+
+// Loads a dense CSV or a MatrixMarket (.mtx) file, parsed in parallel chunks;
+// coordinate files are assembled in CSR first. Prints the parse rate.
+void loadMatrix (const std::string &, Matrix2x2 &);
+
 // Runs a single configuration
-std::pair <float, ValueType> runSingle (FunctionType, const Matrix2x2 &, const Matrix2x2 &, Matrix2x2 &, const std::uint32_t);
+ResultValueType runSingle (FunctionType, const Matrix2x2 &, const Matrix2x2 &, Matrix2x2 &, const std::uint32_t);
 
 // ********** MAIN ********** //
 
@@ -86,11 +908,71 @@ int main (int argc, char* argv[]) {
 	po::options_description desc ("Permitted options");
 	desc.add_options()
 		("help,h", "Print help message")
-		("all,a", "Evaluate default dataset (100-500 with all ijk permutations)")
+		("all,a", "Evaluate default dataset (100-500 with all traversals)")
 		("iterations,i", po::value <std::uint32_t>(&TRIALS)->default_value(TRIALS),
 		 "Number of iterations per invocation")
 		("seed,s", po::value <std::uint32_t> (&SEED)->default_value (SEED),
 		 "RNG seed for matrix generation")
+		("min-value", po::value <std::int32_t> (&MIN_VALUE)->default_value (MIN_VALUE),
+		 "Smallest generated matrix element")
+		("max-value", po::value <std::int32_t> (&MAX_VALUE)->default_value (MAX_VALUE),
+		 "Largest generated matrix element")
+		("digest", po::bool_switch (&DIGEST),
+		 "Show a digest of all of C instead of the sum of its first elements")
+		("golden-cache", po::value <std::string> (&GOLDEN_CACHE),
+		 "Directory of reference results to verify every traversal against")
+		("epilogue", po::value <std::string> (&EPILOGUE)->default_value (EPILOGUE),
+		 "Epilogue of the -fused/-unfused traversals (bias-relu, clamp, requantize)")
+		("chain-panel", po::value <std::uint32_t> (&CHAIN_PANEL)->default_value (CHAIN_PANEL),
+		 "Rows per panel of the fused chain product (0 sizes panels to fit L2)")
+		("splitk-reduce", po::value <std::string> (&SPLITK_REDUCE)->default_value (SPLITK_REDUCE),
+		 "Reduction of split-K partials (tree, atomic, ring)")
+		("schedule", po::value <std::string> (&SCHEDULE)->default_value (SCHEDULE),
+		 "Iteration schedule of the -par traversals (static, cyclic, dynamic, guided)")
+		("chunk", po::value <std::uint32_t> (&CHUNK)->default_value (CHUNK),
+		 "Chunk size of the cyclic, dynamic and guided schedules")
+		("ozaki-slices", po::value <std::uint32_t> (&OZAKI_SLICES)->default_value (OZAKI_SLICES),
+		 "int8 slices per fp64 operand of the ozaki traversal")
+		("inject-faults", po::value <std::uint32_t> (&INJECT_FAULTS)->default_value (INJECT_FAULTS),
+		 "Elements of C corrupted after the product of the -abft traversals")
+		("approx-rank", po::value <std::uint32_t> (&APPROX_RANK)->default_value (APPROX_RANK),
+		 "Samples or sketch size of the approx- traversals (0 derives it from epsilon)")
+		("epsilon", po::value <double> (&EPSILON)->default_value (EPSILON),
+		 "Target error of the approx- traversals relative to |A|_F |B|_F")
+		("deltas", po::value <std::vector <std::uint32_t>> (&DELTAS)->multitoken()->default_value (DELTAS, "1 4 16 64"),
+		 "Rank or rows of the changes applied by the update- traversals (space separated)")
+		("load-a", po::value <std::string> (&LOAD_A),
+		 "CSV or MatrixMarket (.mtx) file to use as A instead of generating it")
+		("load-b", po::value <std::string> (&LOAD_B),
+		 "CSV or MatrixMarket (.mtx) file to use as B instead of generating it")
+		("stream-a", po::value <std::string> (&STREAM_A),
+		 "Raw rows of N native ints the stream traversal multiplies by B (file, FIFO or - for stdin; default streams A)")
+		("stream-c", po::value <std::string> (&STREAM_C),
+		 "Where the stream traversal writes its raw rows of C (- for stdout)")
+		("output-c", po::value <std::string> (&OUTPUT_C),
+		 "Where the ikj-output traversal writes its raw rows of C (default /dev/null)")
+		("stream-panel", po::value <std::uint32_t> (&STREAM_PANEL)->default_value (STREAM_PANEL),
+		 "Rows per panel of the stream and ikj-output traversals")
+		("rounding", po::value <std::string> (&ROUNDING)->default_value (ROUNDING),
+		 "Rounding of Q31 fixed-point products (truncate, half-up, convergent)")
+		("wrap", po::bool_switch (&WRAP),
+		 "Wrap fixed-point results around instead of saturating them")
+		("tiny-size", po::value <std::uint32_t> (&TINY_SIZE)->default_value (TINY_SIZE),
+		 "Dimension (2-8) of the tiny matrices of the batch- traversals")
+		("batch-count", po::value <std::uint32_t> (&BATCH_COUNT)->default_value (BATCH_COUNT),
+		 "Problems per batch of the grouped traversals")
+		("batch-shapes", po::value <std::string> (&BATCH_SHAPES)->default_value (BATCH_SHAPES),
+		 "Distribution of the grouped problem dimensions up to N (uniform, skewed, bimodal)")
+		("mirror", po::bool_switch (&MIRROR),
+		 "Copy the lower triangle computed by the syrk traversals to the upper one")
+		("factor-block", po::value <std::uint32_t> (&FACTOR_BLOCK)->default_value (FACTOR_BLOCK),
+		 "Tile size of the lu- and chol- factorizations")
+		("cutoff,c", po::value <std::uint32_t> (&CUTOFF)->default_value (CUTOFF),
+		 "Size below which fast algorithms fall back to the classic kernel")
+		("threads,j", po::value <std::uint32_t> (&THREADS)->default_value (THREADS),
+		 "Worker threads for parallel traversals")
+		("parallel-depth,d", po::value <std::uint32_t> (&PARALLEL_DEPTH)->default_value (PARALLEL_DEPTH),
+		 "Recursion levels of fast algorithms that run their products as tasks")
 		("sizes,N", po::value <std::vector <std::uint32_t>> (&sizeList)->multitoken(),
 		 "Sizes to evaluate (space separated)")
 		("traversals,t", po::value <std::vector <std::string>> (&orderList)->multitoken(),
@@ -104,23 +986,209 @@ int main (int argc, char* argv[]) {
 		std::exit (EXIT_SUCCESS);
 	}
 
+	if (EPILOGUE != "bias-relu" && EPILOGUE != "clamp" && EPILOGUE != "requantize") {
+		std::cerr << "invalid epilogue provided: " << EPILOGUE << std::endl;
+		std::exit (EXIT_FAILURE);
+	}
+
+	if (SPLITK_REDUCE != "tree" && SPLITK_REDUCE != "atomic" && SPLITK_REDUCE != "ring") {
+		std::cerr << "invalid split-K reduction provided: " << SPLITK_REDUCE << std::endl;
+		std::exit (EXIT_FAILURE);
+	}
+
+	if (MIN_VALUE > MAX_VALUE) {
+		std::cerr << "invalid value range provided: " << MIN_VALUE << " > " << MAX_VALUE << std::endl;
+		std::exit (EXIT_FAILURE);
+	}
+
+	if (OZAKI_SLICES == 0 || OZAKI_SLICES > 8) {
+		std::cerr << "invalid ozaki slices provided: " << OZAKI_SLICES << std::endl;
+		std::exit (EXIT_FAILURE);
+	}
+
+	if (STREAM_PANEL == 0) {
+		std::cerr << "invalid stream panel provided: " << STREAM_PANEL << std::endl;
+		std::exit (EXIT_FAILURE);
+	}
+
+	if (!(EPSILON > 0.0)) {
+		std::cerr << "invalid epsilon provided: " << EPSILON << std::endl;
+		std::exit (EXIT_FAILURE);
+	}
+
+	if (FACTOR_BLOCK == 0) {
+		std::cerr << "invalid factor block provided: " << FACTOR_BLOCK << std::endl;
+		std::exit (EXIT_FAILURE);
+	}
+
+	// A pipe or terminal can only be streamed by a single trial
+	if (!STREAM_A.empty() && TRIALS > 1) {
+		struct stat info;
+		const int found {STREAM_A == "-" ? ::fstat (STDIN_FILENO, &info) : ::stat (STREAM_A.c_str(), &info)};
+		if (found == 0 && !S_ISREG (info.st_mode) && !S_ISBLK (info.st_mode)) {
+			std::cerr << "invalid iterations provided: " << TRIALS << ", " << STREAM_A << " cannot be read more than once" << std::endl;
+			std::exit (EXIT_FAILURE);
+		}
+	}
+
+	if (BATCH_SHAPES != "uniform" && BATCH_SHAPES != "skewed" && BATCH_SHAPES != "bimodal") {
+		std::cerr << "invalid batch shapes provided: " << BATCH_SHAPES << std::endl;
+		std::exit (EXIT_FAILURE);
+	}
+
+	if (TINY_SIZE < 2 || TINY_SIZE > 8) {
+		std::cerr << "invalid tiny size provided: " << TINY_SIZE << std::endl;
+		std::exit (EXIT_FAILURE);
+	}
+
+	if (!ROUNDINGS.count (ROUNDING)) {
+		std::cerr << "invalid rounding provided: " << ROUNDING << std::endl;
+		std::exit (EXIT_FAILURE);
+	}
+
+	if (!SCHEDULES.count (SCHEDULE)) {
+		std::cerr << "invalid schedule provided: " << SCHEDULE << std::endl;
+		std::exit (EXIT_FAILURE);
+	}
+
 	// Check arguments to see if we should automatically run all tests
 	const bool RUN_ALL {vm.count ("all") > 0};
-	const bool CUSTOM {(vm.count ("sizes") > 0 && vm.count ("traversals") > 0) || RUN_ALL};
+	const bool LOADED {vm.count ("load-a") > 0 || vm.count ("load-b") > 0};
+	const bool CUSTOM {((vm.count ("sizes") > 0 || LOADED) && vm.count ("traversals") > 0) || RUN_ALL};
 
 	#define CREATE_MAPPING(X) \
   		{ X , &multiply <Char<0>{X}, Char<1>{X}, Char<2>{X}> }
 
+	#define CREATE_PARALLEL(X) \
+		{ X "-par", &multiplyParallel <Char<0>{X}, Char<1>{X}, Char<2>{X}> }
+
+	#define CREATE_EPILOGUE(X) \
+		{ X "-fused", &multiplyEpilogue <Char<0>{X}, Char<1>{X}, Char<2>{X}, true> }, \
+		{ X "-unfused", &multiplyEpilogue <Char<0>{X}, Char<1>{X}, Char<2>{X}, false> }
+
+	#define CREATE_ABFT(X) \
+		{ X "-abft", std::bind (&multiplyABFT, FunctionType {&multiply <Char<0>{X}, Char<1>{X}, Char<2>{X}>}, \
+			std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4) }
+
+	#define CREATE_INCREMENTAL(X, U) \
+		{ X , std::bind (&multiplyIncremental, U, std::placeholders::_1, \
+			std::placeholders::_2, std::placeholders::_3, std::placeholders::_4) }
+
+	#define CREATE_FIXED(X) \
+		{ "q15-" X, &multiplyFixed <Char<0>{X}, Char<1>{X}, Char<2>{X}, Q15> }, \
+		{ "q31-" X, &multiplyFixed <Char<0>{X}, Char<1>{X}, Char<2>{X}, Q31> }
+
+	#define CREATE_FACTOR(X) \
+		{ "lu-" X, &factorize <Char<0>{X}, Char<1>{X}, Char<2>{X}, false> }, \
+		{ "chol-" X, &factorize <Char<0>{X}, Char<1>{X}, Char<2>{X}, true> }
+
+	#define CREATE_BILINEAR(X, S, P) \
+		{ X , std::bind (&multiplyBilinear, std::cref (S), P, std::placeholders::_1, \
+			std::placeholders::_2, std::placeholders::_3, std::placeholders::_4) }
+
 	const std::map <std::string, FunctionType> FUNCTION_MAP = {
 		CREATE_MAPPING ("ijk"),
 		CREATE_MAPPING ("ikj"),
 		CREATE_MAPPING ("jik"),
 		CREATE_MAPPING ("jki"),
 		CREATE_MAPPING ("kij"),
-		CREATE_MAPPING ("kji")
+		CREATE_MAPPING ("kji"),
+		CREATE_PARALLEL ("ijk"),
+		CREATE_PARALLEL ("ikj"),
+		CREATE_PARALLEL ("jik"),
+		CREATE_PARALLEL ("jki"),
+		CREATE_PARALLEL ("kij"),
+		CREATE_PARALLEL ("kji"),
+		CREATE_EPILOGUE ("ijk"),
+		CREATE_EPILOGUE ("ikj"),
+		CREATE_EPILOGUE ("jik"),
+		CREATE_EPILOGUE ("jki"),
+		CREATE_EPILOGUE ("kij"),
+		CREATE_EPILOGUE ("kji"),
+		CREATE_ABFT ("ijk"),
+		CREATE_ABFT ("ikj"),
+		CREATE_ABFT ("jik"),
+		CREATE_ABFT ("jki"),
+		CREATE_ABFT ("kij"),
+		CREATE_ABFT ("kji"),
+		CREATE_FIXED ("ijk"),
+		CREATE_FIXED ("ikj"),
+		CREATE_FIXED ("jik"),
+		CREATE_FIXED ("jki"),
+		CREATE_FIXED ("kij"),
+		CREATE_FIXED ("kji"),
+		CREATE_FACTOR ("ijk"),
+		CREATE_FACTOR ("ikj"),
+		CREATE_FACTOR ("jik"),
+		CREATE_FACTOR ("jki"),
+		CREATE_FACTOR ("kij"),
+		CREATE_FACTOR ("kji"),
+		CREATE_BILINEAR ("strassen", STRASSEN, false),
+		CREATE_BILINEAR ("laderman", LADERMAN, false),
+		CREATE_BILINEAR ("strassen-par", STRASSEN, true),
+		CREATE_BILINEAR ("laderman-par", LADERMAN, true),
+		CREATE_BILINEAR ("strassen-223", STRASSEN_223, false),
+		CREATE_BILINEAR ("strassen-223-par", STRASSEN_223, true),
+		{ "chain-fused", &multiplyChain <true> },
+		{ "chain-unfused", &multiplyChain <false> },
+		{ "splitk", &multiplySplitK },
+		{ "ikj-auto", &multiplyAutoWidth },
+		{ "ikj-i64", &multiplyFixedWidth <std::int64_t> },
+		{ "ikj-i128", &multiplyFixedWidth <WideType> },
+		{ "crt", &multiplyCRT },
+		{ "ikj-f64", &multiplyDouble },
+		{ "ozaki", &multiplyOzaki },
+		{ "approx-sample", &multiplySampled },
+		{ "approx-sketch", &multiplySketched },
+		CREATE_INCREMENTAL ("update-rank", Update::RANK),
+		CREATE_INCREMENTAL ("update-rows", Update::ROWS),
+		CREATE_INCREMENTAL ("update-append", Update::APPEND),
+		{ "stream", &multiplyStream },
+		{ "ikj-output", &multiplyOutput },
+		{ "ikj-panel", &multiplyPanels <false> },
+		{ "ikj-bitpacked", &multiplyPanels <true> },
+		{ "int8", &multiplyInt8 <true> },
+		{ "int8-ref", &multiplyInt8 <false> },
+		{ "int4", &multiplyInt4 <true> },
+		{ "int4-ref", &multiplyInt4 <false> },
+		{ "sparse24", &multiplySparse24 <true> },
+		{ "sparse24-ref", &multiplySparse24 <false> },
+		{ "batch-plain", &multiplyBatch <false> },
+		{ "batch-interleaved", &multiplyBatch <true> },
+		{ "grouped", &multiplyGrouped <true> },
+		{ "grouped-naive", &multiplyGrouped <false> },
+		{ "syrk", &multiplySyrk <false> },
+		{ "syrk-par", &multiplySyrk <true> }
 	};
 
 	#undef CREATE_MAPPING
+	#undef CREATE_PARALLEL
+	#undef CREATE_EPILOGUE
+	#undef CREATE_ABFT
+	#undef CREATE_INCREMENTAL
+	#undef CREATE_FIXED
+	#undef CREATE_FACTOR
+	#undef CREATE_BILINEAR
+
+	// Traversals whose result is not A * B, so the golden cache cannot verify them
+	std::set <std::string> NON_PRODUCTS {"chain-fused", "chain-unfused", "ikj-f64", "ozaki",
+		"approx-sample", "approx-sketch", "update-rank", "update-rows",
+		"int8", "int8-ref", "int4", "int4-ref", "sparse24", "sparse24-ref",
+		"batch-plain", "batch-interleaved", "grouped", "grouped-naive", "syrk", "syrk-par"};
+	if (!STREAM_A.empty())
+		NON_PRODUCTS.insert ("stream");
+	for (const char * order : {"ijk", "ikj", "jik", "jki", "kij", "kji"}) {
+		NON_PRODUCTS.insert (std::string {"q15-"} + order);
+		NON_PRODUCTS.insert (std::string {"q31-"} + order);
+		NON_PRODUCTS.insert (std::string {"lu-"} + order);
+		NON_PRODUCTS.insert (std::string {"chol-"} + order);
+		NON_PRODUCTS.insert (std::string {order} + "-fused");
+		NON_PRODUCTS.insert (std::string {order} + "-unfused");
+	}
+
+	for (const BilinearScheme * scheme : { &STRASSEN, &LADERMAN, &STRASSEN_223 })
+		if (!validScheme (*scheme))
+			throw std::logic_error ("bilinear scheme violates the Brent equations");
 
 	if (RUN_ALL) {
 		sizeList = { 100, 200, 300, 400, 500 };
@@ -144,20 +1212,67 @@ int main (int argc, char* argv[]) {
 		orderList = { order };
 	}
 
-	// Initialize RNG
-	EngineType eng {SEED};
-	DistributionType dist {0, 4};
-	GeneratorType gen {std::bind (dist, eng)};
+	// Loaded operands replace the generated ones and fix the size
+	Matrix2x2 loadedA, loadedB;
+	try {
+		if (!LOAD_A.empty())
+			loadMatrix (LOAD_A, loadedA);
+		if (!LOAD_B.empty())
+			loadMatrix (LOAD_B, loadedB);
+	} catch (std::runtime_error &ex) {
+		std::cerr << "invalid matrix file provided: " << ex.what() << std::endl;
+		std::exit (EXIT_FAILURE);
+	}
+	if (LOADED) {
+		const Matrix2x2 & loaded = LOAD_A.empty() ? loadedB : loadedA;
+		const std::uint32_t N = loaded.shape()[0];
+		for (const Matrix2x2 * M : { &loadedA, &loadedB })
+			if (M->num_elements() > 0 && (M->shape()[0] != N || M->shape()[1] != N)) {
+				std::cerr << "invalid loaded matrix provided: " << M->shape()[0] << "x" << M->shape()[1]
+					<< ", expected " << N << "x" << N << std::endl;
+				std::exit (EXIT_FAILURE);
+			}
+		sizeList = { N };
+	}
+
+	// Initialize RNG
+	EngineType eng {SEED};
+	DistributionType dist {MIN_VALUE, MAX_VALUE};
+	GeneratorType gen {std::bind (dist, eng)};
 
 	ResultsType results;
+	StatsType stats;
+	std::map <ResultKeyType, std::string> verification;
+
+	// Identifies the generated inputs in golden-result cache keys
+	std::ostringstream generator;
+	generator << "s" << SEED << "-mt19937_64-uniform" << dist.a() << "_" << dist.b()
+		<< "-i" << 8 * sizeof (ValueType);
 
 	for (auto N : sizeList) {
 		Matrix2x2 A {boost::extents[N][N]};
 		Matrix2x2 B {boost::extents[N][N]};
 		Matrix2x2 C {boost::extents[N][N]};
 
-		std::generate_n (A.data(), A.num_elements(), gen);
-		std::generate_n (B.data(), B.num_elements(), gen);
+		if (LOAD_A.empty())
+			std::generate_n (A.data(), A.num_elements(), gen);
+		else
+			A = loadedA;
+		if (LOAD_B.empty())
+			std::generate_n (B.data(), B.num_elements(), gen);
+		else
+			B = loadedB;
+
+		GoldenResult golden;
+		if (!GOLDEN_CACHE.empty()) {
+			std::ostringstream key;
+			key << generator.str() << "-n" << N;
+			if (!LOAD_A.empty())
+				key << "-a" << toHex (matrixDigest (A));
+			if (!LOAD_B.empty())
+				key << "-b" << toHex (matrixDigest (B));
+			golden = goldenResult (key.str(), A, B, N);
+		}
 
 		for (auto order : orderList) {
 			try {
@@ -165,15 +1280,32 @@ int main (int argc, char* argv[]) {
 					<< "Trials for " << N << " with order " << order << "    " << '\r';
 
 				results.insert ({{N, order}, runSingle (FUNCTION_MAP.at (order), A, B, C, N)});
+				for (const auto & stat : TRIAL_STATS)
+					stats[stat.first][{N, order}] = stat.second.first / stat.second.second;
+				if (!GOLDEN_CACHE.empty())
+					verification[{N, order}] = NON_PRODUCTS.count (order) ? "n/a" : verify (golden, C);
 
 				conditionalPrint (std::cout, !CUSTOM)
 					<< "-- BEGIN OUTPUT --\n"
-					<< "Time (us) = " << results[{N, order}].first << "\n"
-					<< "Sum       = " << results[{N, order}].second << "\n"
+					<< "Time (us) = " << std::get <0> (results[{N, order}]) << "\n"
+					<< "Sum       = " << std::get <1> (results[{N, order}]) << "\n";
+				if (DIGEST)
+					conditionalPrint (std::cout, !CUSTOM)
+						<< "Digest    = " << toHex (std::get <2> (results[{N, order}])) << "\n";
+				if (!GOLDEN_CACHE.empty())
+					conditionalPrint (std::cout, !CUSTOM)
+						<< "Verified  = " << verification[{N, order}] << "\n";
+				for (const auto & stat : TRIAL_STATS)
+					conditionalPrint (std::cout, !CUSTOM)
+						<< stat.first << " " << stat.second.first / stat.second.second << "\n";
+				conditionalPrint (std::cout, !CUSTOM)
 					<< "-- END OUTPUT --" << std::endl;
 			} catch (std::out_of_range &ex) {
 				std::cerr << "invalid traversal provided: " << order << std::endl;
 				std::exit (EXIT_FAILURE);
+			} catch (std::runtime_error &ex) {
+				std::cerr << "invalid stream provided to " << order << ": " << ex.what() << std::endl;
+				std::exit (EXIT_FAILURE);
 			}
 		}
 	}
@@ -184,10 +1316,40 @@ int main (int argc, char* argv[]) {
 			[&results] (const ResultKeyType & key) {
 				return std::get <0> (results.at (key));
 			})
-		<< print ("SUMS:", orderList, sizeList,
-			[&results] (const ResultKeyType & key) {
-				return std::get <1> (results.at (key));
+		<< (DIGEST
+			? print ("DIGESTS:", orderList, sizeList,
+				[&results] (const ResultKeyType & key) {
+					return toHex (std::get <2> (results.at (key)));
+				})
+			: print ("SUMS:", orderList, sizeList,
+				[&results] (const ResultKeyType & key) {
+					return std::get <1> (results.at (key));
+				}));
+
+	if (!GOLDEN_CACHE.empty())
+		conditionalPrint (std::cout, CUSTOM)
+			<< print ("VERIFICATION:", orderList, sizeList,
+				[&verification] (const ResultKeyType & key) {
+					return verification.at (key);
+				});
+
+	// Kernel statistics, for the traversals that reported them at every size
+	for (const auto & stat : stats) {
+		std::vector <std::string> reported;
+		std::copy_if (std::begin (orderList), std::end (orderList), std::back_inserter (reported),
+			[&] (const std::string & order) {
+				return std::all_of (std::begin (sizeList), std::end (sizeList),
+					[&] (std::uint32_t N) {
+						return stat.second.count ({N, order}) > 0;
+					});
 			});
+		if (!reported.empty())
+			conditionalPrint (std::cout, CUSTOM)
+				<< print (stat.first, reported, sizeList,
+					[&stat] (const ResultKeyType & key) {
+						return stat.second.at (key);
+					});
+	}
 
 	return EXIT_SUCCESS;
 }
@@ -195,23 +1357,31 @@ int main (int argc, char* argv[]) {
 ResultValueType
 runSingle (FunctionType mmult, const Matrix2x2 & A, const Matrix2x2 & B, Matrix2x2 & C, const std::uint32_t N) {
 	std::uint64_t timeSum {0};
+	TRIAL_STATS.clear();
 	for (std::uint32_t count {0}; count < TRIALS; ++count) {
 		std::fill_n (C.data(), C.num_elements(), 0);
 		timeSum += mmult (A, B, C, N);
 	}
 	uint32_t elements = C.num_elements();
-	return {
+	return ResultValueType {
 		1.0 * timeSum / TRIALS,
-		std::accumulate (C.data(), C.data() + std::min (CHECKSUM_MAX, elements), 0)
+		std::accumulate (C.data(), C.data() + std::min (CHECKSUM_MAX, elements), 0),
+		DIGEST ? matrixDigest (C) : 0
 	};
 }
 
+void reportStat (const std::string & title, double value) {
+	auto & stat = TRIAL_STATS[title];
+	stat.first += value;
+	++stat.second;
+}
+
 template <typename Callable>
 std::string
 print (const std::string & title, std::vector <std::string> & orderList, std::vector <std::uint32_t> & sizeList, Callable && dataAccessor) {
 	const static std::uint32_t FP_PRECISION {1};
 	const static std::uint32_t HEADING_WIDTH {7};
-	const static std::uint32_t DATA_WIDTH {15};
+	const static std::uint32_t DATA_WIDTH {16};
 
 	std::ostringstream oss;
 
@@ -257,16 +1427,2598 @@ constexpr std::uint32_t getIndex (std::uint32_t index) {
 #define _(X) \
 	std::get <getIndex <char, Char <0> {TO_STR (X)}, L1, L2, L3> (0)> (std::tie (i, j, k))
 
+// Traversal restricted to [lo, hi) of the outermost of i and j, so that
+// disjoint ranges write disjoint parts of C. The epilogue is applied to each
+// part of C as soon as it is final: an element when k is innermost, a row or
+// column when k is the middle loop, and the whole range when k is outermost.
+template <char L1, char L2, char L3, typename Epilogue = NoEpilogue>
+void multiplyKernel (const Matrix2x2 & A, const Matrix2x2 & B, Matrix2x2 & C, const uint32_t N, const std::uint32_t lo, const std::uint32_t hi,
+	const Epilogue & epilogue = Epilogue {}) {
+	constexpr char P {L1 != 'k' ? L1 : L2};
+	for (std::uint32_t i{L1 == P ? lo : 0}; i < (L1 == P ? hi : N); ++i) {
+		for (std::uint32_t j{L2 == P ? lo : 0}; j < (L2 == P ? hi : N); ++j) {
+			for (std::uint32_t k{0}; k < N; ++k)
+				C[_(i)][_(j)] += A[_(i)][_(k)] * B[_(k)][_(j)];
+			if (Epilogue::ENABLED && L3 == 'k') {
+				ValueType & c = (L1 == 'i') ? C[i][j] : C[j][i];
+				c = epilogue (c, L1 == 'i' ? j : i);
+			}
+		}
+		if (L2 == 'k')
+			applyEpilogue (C, L1 == 'i' ? i : 0, L1 == 'i' ? i + 1 : N, L1 == 'j' ? i : 0, L1 == 'j' ? i + 1 : N, epilogue);
+	}
+	if (L1 == 'k')
+		applyEpilogue (C, P == 'i' ? lo : 0, P == 'i' ? hi : N, P == 'j' ? lo : 0, P == 'j' ? hi : N, epilogue);
+}
+
 template <char L1, char L2, char L3>
 std::uint64_t multiply (const Matrix2x2 & A, const Matrix2x2 & B, Matrix2x2 & C, const uint32_t N) {
 	auto startTime = std::chrono::high_resolution_clock::now();
-	for (std::uint32_t i{0}; i < N; ++i)
-		for (std::uint32_t j{0}; j < N; ++j)
-			for (std::uint32_t k{0}; k < N; ++k)
-				C[_(i)][_(j)] += A[_(i)][_(k)] * B[_(k)][_(j)];
+	multiplyKernel <L1, L2, L3> (A, B, C, N, 0, N);
+	auto stopTime = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration_cast <std::chrono::microseconds> (stopTime - startTime).count();
+}
+
+template <char L1, char L2, char L3>
+std::uint64_t multiplyParallel (const Matrix2x2 & A, const Matrix2x2 & B, Matrix2x2 & C, const uint32_t N) {
+	auto startTime = std::chrono::high_resolution_clock::now();
+	const double imbalance {parallelFor (N, [&] (std::uint32_t lo, std::uint32_t hi) {
+		multiplyKernel <L1, L2, L3> (A, B, C, N, lo, hi);
+	}, SCHEDULES.at (SCHEDULE), CHUNK)};
+	auto stopTime = std::chrono::high_resolution_clock::now();
+	reportStat ("LOAD IMBALANCE (% OVER MEAN):", 100 * (imbalance - 1));
+	return std::chrono::duration_cast <std::chrono::microseconds> (stopTime - startTime).count();
+}
+
+template <typename Epilogue>
+void applyEpilogue (Matrix2x2 & C, std::uint32_t rowLo, std::uint32_t rowHi, std::uint32_t colLo, std::uint32_t colHi, const Epilogue & epilogue) {
+	if (!Epilogue::ENABLED)
+		return;
+	for (std::uint32_t i{rowLo}; i < rowHi; ++i)
+		for (std::uint32_t j{colLo}; j < colHi; ++j)
+			C[i][j] = epilogue (C[i][j], j);
+}
+
+template <char L1, char L2, char L3, bool Fused, typename Epilogue>
+std::uint64_t multiplyWithEpilogue (const Matrix2x2 & A, const Matrix2x2 & B, Matrix2x2 & C, const uint32_t N, const Epilogue & epilogue) {
+	auto startTime = std::chrono::high_resolution_clock::now();
+	if (Fused) {
+		multiplyKernel <L1, L2, L3> (A, B, C, N, 0, N, epilogue);
+	} else {
+		multiplyKernel <L1, L2, L3> (A, B, C, N, 0, N);
+		applyEpilogue (C, 0, N, 0, N, epilogue);
+	}
 	auto stopTime = std::chrono::high_resolution_clock::now();
 	return std::chrono::duration_cast <std::chrono::microseconds> (stopTime - startTime).count();
 }
 
+template <char L1, char L2, char L3, bool Fused>
+std::uint64_t multiplyEpilogue (const Matrix2x2 & A, const Matrix2x2 & B, Matrix2x2 & C, const uint32_t N) {
+	std::vector <ValueType> bias (N);
+	for (std::uint32_t j{0}; j < N; ++j)
+		bias[j] = static_cast <ValueType> (j % 9) - 4;
+	if (EPILOGUE == "clamp")
+		return multiplyWithEpilogue <L1, L2, L3, Fused> (A, B, C, N, ClampEpilogue {CLAMP_MIN, CLAMP_MAX});
+	if (EPILOGUE == "requantize")
+		return multiplyWithEpilogue <L1, L2, L3, Fused> (A, B, C, N, RequantizeEpilogue {bias.data(), REQUANTIZE_MULTIPLIER, REQUANTIZE_SHIFT});
+	return multiplyWithEpilogue <L1, L2, L3, Fused> (A, B, C, N, BiasReluEpilogue {bias.data()});
+}
+
 #undef TO_STR
 #undef _
+
+// ********** PARALLELISM ********** //
+
+ThreadPool & threadPool () {
+	static ThreadPool pool {std::max <std::uint32_t> (THREADS, 1)};
+	return pool;
+}
+
+Arena & threadArena () {
+	static thread_local Arena arena;
+	return arena;
+}
+
+// dst[0, count) += src[0, count)
+void addInto (ValueType * __restrict__ dst, const ValueType * __restrict__ src, std::size_t count) {
+	for (std::size_t e{0}; e < count; ++e)
+		dst[e] += src[e];
+}
+
+double parallelFor (std::uint32_t count, const std::function <void (std::uint32_t, std::uint32_t)> & body, Schedule schedule, std::uint32_t chunk) {
+	ThreadPool & pool = threadPool();
+	const std::uint32_t workers {std::min (pool.size(), count)};
+	if (workers == 0)
+		return 1;
+	chunk = std::max <std::uint32_t> (chunk, 1);
+
+	std::atomic <std::uint32_t> next {0};
+	std::vector <double> busy (workers);
+	auto work = [&] (std::uint32_t worker) {
+		auto startTime = std::chrono::steady_clock::now();
+		switch (schedule) {
+		case Schedule::STATIC:
+			body (std::uint64_t {count} * worker / workers, std::uint64_t {count} * (worker + 1) / workers);
+			break;
+		case Schedule::CYCLIC:
+			for (std::uint64_t lo {std::uint64_t {worker} * chunk}; lo < count; lo += std::uint64_t {workers} * chunk)
+				body (lo, std::min <std::uint64_t> (lo + chunk, count));
+			break;
+		case Schedule::DYNAMIC:
+			for (std::uint64_t lo {next.fetch_add (chunk)}; lo < count; lo = next.fetch_add (chunk))
+				body (lo, std::min <std::uint64_t> (lo + chunk, count));
+			break;
+		case Schedule::GUIDED:
+			for (std::uint32_t lo {next.load()}; lo < count;) {
+				const std::uint32_t size {std::min (count - lo, std::max (chunk, (count - lo) / (2 * workers)))};
+				if (next.compare_exchange_weak (lo, lo + size)) {
+					body (lo, lo + size);
+					lo = next.load();
+				}
+			}
+			break;
+		}
+		busy[worker] = std::chrono::duration <double> (std::chrono::steady_clock::now() - startTime).count();
+	};
+
+	TaskGroup group {pool};
+	for (std::uint32_t worker{1}; worker < workers; ++worker)
+		group.run ([&work, worker] {
+			work (worker);
+		});
+	work (0);
+	group.wait();
+
+	const double mean {std::accumulate (std::begin (busy), std::end (busy), 0.0) / workers};
+	return mean > 0 ? *std::max_element (std::begin (busy), std::end (busy)) / mean : 1;
+}
+
+// ********** BILINEAR ALGORITHMS ********** //
+
+const BilinearScheme STRASSEN {2, 2, 2, 7, {
+	// U (A11..A22)      V (B11..B22)      W (C11..C22)
+	 1,  0,  0,  1,    1,  0,  0,  1,    1,  0,  0,  1,
+	 0,  0,  1,  1,    1,  0,  0,  0,    0,  0,  1, -1,
+	 1,  0,  0,  0,    0,  1,  0, -1,    0,  1,  0,  1,
+	 0,  0,  0,  1,   -1,  0,  1,  0,    1,  0,  1,  0,
+	 1,  1,  0,  0,    0,  0,  0,  1,   -1,  1,  0,  0,
+	-1,  0,  1,  0,    1,  1,  0,  0,    0,  0,  0,  1,
+	 0,  1,  0, -1,    0,  0,  1,  1,    1,  0,  0,  0
+}};
+
+const BilinearScheme LADERMAN {3, 3, 3, 23, {
+	// U (A11..A33)                        V (B11..B33)                        W (C11..C33)
+	 1,  1,  1, -1, -1,  0,  0, -1, -1,    0,  0,  0,  0,  1,  0,  0,  0,  0,    0,  1,  0,  0,  0,  0,  0,  0,  0,
+	 1,  0,  0, -1,  0,  0,  0,  0,  0,    0, -1,  0,  0,  1,  0,  0,  0,  0,    0,  0,  0,  1,  1,  0,  0,  0,  0,
+	 0,  0,  0,  0,  1,  0,  0,  0,  0,   -1,  1,  0,  1, -1, -1, -1,  0,  1,    0,  0,  0,  1,  0,  0,  0,  0,  0,
+	-1,  0,  0,  1,  1,  0,  0,  0,  0,    1, -1,  0,  0,  1,  0,  0,  0,  0,    0,  1,  0,  1,  1,  0,  0,  0,  0,
+	 0,  0,  0,  1,  1,  0,  0,  0,  0,   -1,  1,  0,  0,  0,  0,  0,  0,  0,    0,  1,  0,  0,  1,  0,  0,  0,  0,
+	 1,  0,  0,  0,  0,  0,  0,  0,  0,    1,  0,  0,  0,  0,  0,  0,  0,  0,    1,  1,  1,  1,  1,  0,  1,  0,  1,
+	-1,  0,  0,  0,  0,  0,  1,  1,  0,    1,  0, -1,  0,  0,  1,  0,  0,  0,    0,  0,  1,  0,  0,  0,  1,  0,  1,
+	-1,  0,  0,  0,  0,  0,  1,  0,  0,    0,  0,  1,  0,  0, -1,  0,  0,  0,    0,  0,  0,  0,  0,  0,  1,  0,  1,
+	 0,  0,  0,  0,  0,  0,  1,  1,  0,   -1,  0,  1,  0,  0,  0,  0,  0,  0,    0,  0,  1,  0,  0,  0,  0,  0,  1,
+	 1,  1,  1,  0, -1, -1, -1, -1,  0,    0,  0,  0,  0,  0,  1,  0,  0,  0,    0,  0,  1,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  0,  1,  0,   -1,  0,  1,  1, -1, -1, -1,  1,  0,    0,  0,  0,  0,  0,  0,  1,  0,  0,
+	 0,  0, -1,  0,  0,  0,  0,  1,  1,    0,  0,  0,  0,  1,  0,  1, -1,  0,    0,  1,  0,  0,  0,  0,  1,  1,  0,
+	 0,  0,  1,  0,  0,  0,  0,  0, -1,    0,  0,  0,  0,  1,  0,  0, -1,  0,    0,  0,  0,  0,  0,  0,  1,  1,  0,
+	 0,  0,  1,  0,  0,  0,  0,  0,  0,    0,  0,  0,  0,  0,  0,  1,  0,  0,    1,  1,  1,  1,  0,  1,  1,  1,  0,
+	 0,  0,  0,  0,  0,  0,  0,  1,  1,    0,  0,  0,  0,  0,  0, -1,  1,  0,    0,  1,  0,  0,  0,  0,  0,  1,  0,
+	 0,  0, -1,  0,  1,  1,  0,  0,  0,    0,  0,  0,  0,  0,  1,  1,  0, -1,    0,  0,  1,  1,  0,  1,  0,  0,  0,
+	 0,  0,  1,  0,  0, -1,  0,  0,  0,    0,  0,  0,  0,  0,  1,  0,  0, -1,    0,  0,  0,  1,  0,  1,  0,  0,  0,
+	 0,  0,  0,  0,  1,  1,  0,  0,  0,    0,  0,  0,  0,  0,  0, -1,  0,  1,    0,  0,  1,  0,  0,  1,  0,  0,  0,
+	 0,  1,  0,  0,  0,  0,  0,  0,  0,    0,  0,  0,  1,  0,  0,  0,  0,  0,    1,  0,  0,  0,  0,  0,  0,  0,  0,
+	 0,  0,  0,  0,  0,  1,  0,  0,  0,    0,  0,  0,  0,  0,  0,  0,  1,  0,    0,  0,  0,  0,  1,  0,  0,  0,  0,
+	 0,  0,  0,  1,  0,  0,  0,  0,  0,    0,  0,  1,  0,  0,  0,  0,  0,  0,    0,  0,  0,  0,  0,  1,  0,  0,  0,
+	 0,  0,  0,  0,  0,  0,  1,  0,  0,    0,  1,  0,  0,  0,  0,  0,  0,  0,    0,  0,  0,  0,  0,  0,  0,  1,  0,
+	 0,  0,  0,  0,  0,  0,  0,  0,  1,    0,  0,  0,  0,  0,  0,  0,  0,  1,    0,  0,  0,  0,  0,  0,  0,  0,  1
+}};
+
+// Rectangular <2,2,3:11>: Strassen on the first two block columns of B and C,
+// the classic four products on the third (rank 11 is optimal for this shape)
+const BilinearScheme STRASSEN_223 {2, 2, 3, 11, {
+	// U (A11..A22)      V (B11..B23)                W (C11..C23)
+	 1,  0,  0,  1,    1,  0,  0,  0,  1,  0,    1,  0,  0,  0,  1,  0,
+	 0,  0,  1,  1,    1,  0,  0,  0,  0,  0,    0,  0,  0,  1, -1,  0,
+	 1,  0,  0,  0,    0,  1,  0,  0, -1,  0,    0,  1,  0,  0,  1,  0,
+	 0,  0,  0,  1,   -1,  0,  0,  1,  0,  0,    1,  0,  0,  1,  0,  0,
+	 1,  1,  0,  0,    0,  0,  0,  0,  1,  0,   -1,  1,  0,  0,  0,  0,
+	-1,  0,  1,  0,    1,  1,  0,  0,  0,  0,    0,  0,  0,  0,  1,  0,
+	 0,  1,  0, -1,    0,  0,  0,  1,  1,  0,    1,  0,  0,  0,  0,  0,
+	 1,  0,  0,  0,    0,  0,  1,  0,  0,  0,    0,  0,  1,  0,  0,  0,
+	 0,  1,  0,  0,    0,  0,  0,  0,  0,  1,    0,  0,  1,  0,  0,  0,
+	 0,  0,  1,  0,    0,  0,  1,  0,  0,  0,    0,  0,  0,  0,  0,  1,
+	 0,  0,  0,  1,    0,  0,  0,  0,  0,  1,    0,  0,  0,  0,  0,  1
+}};
+
+bool validScheme (const BilinearScheme & s) {
+	if (s.table.size() != s.r * s.width())
+		return false;
+	for (std::uint32_t i{0}; i < s.m; ++i)
+		for (std::uint32_t l{0}; l < s.k; ++l)
+			for (std::uint32_t l2{0}; l2 < s.k; ++l2)
+				for (std::uint32_t j{0}; j < s.n; ++j)
+					for (std::uint32_t i2{0}; i2 < s.m; ++i2)
+						for (std::uint32_t j2{0}; j2 < s.n; ++j2) {
+							int sum {0};
+							for (std::uint32_t p{0}; p < s.r; ++p)
+								sum += s.u (p)[i * s.k + l] * s.v (p)[l2 * s.n + j] * s.w (p)[i2 * s.n + j2];
+							if (sum != (i == i2 && l == l2 && j == j2))
+								return false;
+						}
+	return true;
+}
+
+// Classic (ikj) kernel on strided blocks: C += A * B
+void multiplyBlock (const ValueType * A, std::uint32_t lda, const ValueType * B, std::uint32_t ldb,
+	ValueType * C, std::uint32_t ldc, std::uint32_t M, std::uint32_t K, std::uint32_t N) {
+	for (std::uint32_t i{0}; i < M; ++i) {
+		ValueType * __restrict__ c {C + std::size_t {i} * ldc};
+		for (std::uint32_t k{0}; k < K; ++k) {
+			const ValueType a {A[std::size_t {i} * lda + k]};
+			const ValueType * __restrict__ b {B + std::size_t {k} * ldb};
+			for (std::uint32_t j{0}; j < N; ++j)
+				c[j] += a * b[j];
+		}
+	}
+}
+
+// Forms sum (coeff[b] * block b) of X, split into blockRows x blockCols blocks of
+// rows x cols each. A lone unit coefficient yields a view of X instead of a copy.
+std::pair <const ValueType *, std::uint32_t>
+combineBlocks (const int * coeff, std::uint32_t blockRows, std::uint32_t blockCols,
+	const ValueType * X, std::uint32_t ldx, std::uint32_t rows, std::uint32_t cols, ValueType * T) {
+	const std::uint32_t blocks {blockRows * blockCols};
+	if (std::count_if (coeff, coeff + blocks, [] (int c) { return c != 0; }) == 1) {
+		const std::uint32_t b (std::find_if (coeff, coeff + blocks, [] (int c) { return c != 0; }) - coeff);
+		if (coeff[b] == 1)
+			return { X + std::size_t {b / blockCols} * rows * ldx + (b % blockCols) * cols, ldx };
+	}
+	std::fill_n (T, rows * cols, 0);
+	for (std::uint32_t b{0}; b < blocks; ++b) {
+		if (coeff[b] == 0)
+			continue;
+		const ValueType * block {X + std::size_t {b / blockCols} * rows * ldx + (b % blockCols) * cols};
+		for (std::uint32_t i{0}; i < rows; ++i) {
+			const ValueType * __restrict__ x {block + std::size_t {i} * ldx};
+			ValueType * __restrict__ t {T + std::size_t {i} * cols};
+			for (std::uint32_t j{0}; j < cols; ++j)
+				t[j] += coeff[b] * x[j];
+		}
+	}
+	return { T, cols };
+}
+
+// C block += coeff * P for a product P of rows x cols
+void accumulateBlock (int coeff, const ValueType * P, ValueType * block, std::uint32_t ldc, std::uint32_t rows, std::uint32_t cols) {
+	for (std::uint32_t i{0}; i < rows; ++i) {
+		const ValueType * __restrict__ p {P + std::size_t {i} * cols};
+		ValueType * __restrict__ c {block + std::size_t {i} * ldc};
+		for (std::uint32_t j{0}; j < cols; ++j)
+			c[j] += coeff * p[j];
+	}
+}
+
+// Scatters a product P (rows x cols) into every block of C it contributes to
+void scatterProduct (const int * coeff, std::uint32_t blockRows, std::uint32_t blockCols,
+	const ValueType * P, ValueType * C, std::uint32_t ldc, std::uint32_t rows, std::uint32_t cols) {
+	for (std::uint32_t b{0}; b < blockRows * blockCols; ++b)
+		if (coeff[b] != 0)
+			accumulateBlock (coeff[b], P, C + std::size_t {b / blockCols} * rows * ldc + (b % blockCols) * cols, ldc, rows, cols);
+}
+
+// Arena elements one thread needs below a recursion level: the operands and
+// product of each sequential level, or all r products of a parallel level plus
+// the operands of the task the thread runs itself
+std::size_t bilinearWorkspace (const BilinearScheme & s, std::uint32_t M, std::uint32_t K, std::uint32_t N,
+	std::uint32_t levels, std::uint32_t parallelLevels) {
+	if (levels == 0)
+		return 0;
+	const std::uint32_t mb {M / s.m}, kb {K / s.k}, nb {N / s.n};
+	const std::size_t operands {Arena::footprint (std::size_t {mb} * kb) + Arena::footprint (std::size_t {kb} * nb)};
+	const std::size_t product {Arena::footprint (std::size_t {mb} * nb)};
+	const std::size_t below {bilinearWorkspace (s, mb, kb, nb, levels - 1, parallelLevels > 0 ? parallelLevels - 1 : 0)};
+	return (parallelLevels > 0 ? s.r * product : product) + operands + below;
+}
+
+// C += A * B for M x K and K x N operands divisible by the scheme `levels` times.
+// The first parallelLevels levels run their products as pool tasks. Workspace
+// comes from the arena of the thread running each level.
+void bilinearRecurse (const BilinearScheme & s, const ValueType * A, std::uint32_t lda,
+	const ValueType * B, std::uint32_t ldb, ValueType * C, std::uint32_t ldc,
+	std::uint32_t M, std::uint32_t K, std::uint32_t N, std::uint32_t levels, std::uint32_t parallelLevels) {
+	if (levels == 0) {
+		multiplyBlock (A, lda, B, ldb, C, ldc, M, K, N);
+		return;
+	}
+	const std::uint32_t mb {M / s.m}, kb {K / s.k}, nb {N / s.n};
+	Arena & arena = threadArena();
+	ArenaScope scope {arena};
+	if (parallelLevels > 0) {
+		// The products outlive the tasks, so they live in the parent's arena
+		std::vector <ValueType *> P (s.r);
+		for (auto & product : P)
+			product = arena.allocateZeroed (std::size_t {mb} * nb);
+		const std::size_t taskWorkspace {bilinearWorkspace (s, M, K, N, levels, parallelLevels) - s.r * Arena::footprint (std::size_t {mb} * nb)};
+		TaskGroup group {threadPool()};
+		for (std::uint32_t p{0}; p < s.r; ++p)
+			group.run ([&, p] {
+				Arena & local = threadArena();
+				local.reserve (taskWorkspace);
+				ArenaScope scope {local};
+				auto a = combineBlocks (s.u (p), s.m, s.k, A, lda, mb, kb, local.allocate (std::size_t {mb} * kb));
+				auto b = combineBlocks (s.v (p), s.k, s.n, B, ldb, kb, nb, local.allocate (std::size_t {kb} * nb));
+				bilinearRecurse (s, a.first, a.second, b.first, b.second, P[p], nb, mb, kb, nb, levels - 1, parallelLevels - 1);
+			});
+		group.wait();
+		// Blocks of C are disjoint, so each one gathers its products in parallel
+		for (std::uint32_t block{0}; block < s.m * s.n; ++block)
+			group.run ([&, block] {
+				ValueType * c {C + std::size_t {block / s.n} * mb * ldc + (block % s.n) * nb};
+				for (std::uint32_t p{0}; p < s.r; ++p)
+					if (s.w (p)[block] != 0)
+						accumulateBlock (s.w (p)[block], P[p], c, ldc, mb, nb);
+			});
+		group.wait();
+		return;
+	}
+	ValueType * TA {arena.allocate (std::size_t {mb} * kb)};
+	ValueType * TB {arena.allocate (std::size_t {kb} * nb)};
+	ValueType * P {arena.allocate (std::size_t {mb} * nb)};
+	for (std::uint32_t p{0}; p < s.r; ++p) {
+		auto a = combineBlocks (s.u (p), s.m, s.k, A, lda, mb, kb, TA);
+		auto b = combineBlocks (s.v (p), s.k, s.n, B, ldb, kb, nb, TB);
+		std::fill_n (P, std::size_t {mb} * nb, 0);
+		bilinearRecurse (s, a.first, a.second, b.first, b.second, P, nb, mb, kb, nb, levels - 1, 0);
+		scatterProduct (s.w (p), s.m, s.n, P, C, ldc, mb, nb);
+	}
+}
+
+std::uint64_t multiplyBilinear (const BilinearScheme & s, bool parallel, const Matrix2x2 & A, const Matrix2x2 & B, Matrix2x2 & C, const std::uint32_t N) {
+	auto startTime = std::chrono::high_resolution_clock::now();
+
+	// Recurse while every dimension exceeds the cutoff, then pad each dimension
+	// up to a multiple of its block count at every level
+	std::uint32_t levels {0}, PM {N}, PK {N}, PN {N};
+	while (std::min ({PM, PK, PN}) > std::max <std::uint32_t> (CUTOFF, 1)) {
+		PM = (PM + s.m - 1) / s.m;
+		PK = (PK + s.k - 1) / s.k;
+		PN = (PN + s.n - 1) / s.n;
+		++levels;
+	}
+	for (std::uint32_t level{0}; level < levels; ++level) {
+		PM *= s.m;
+		PK *= s.k;
+		PN *= s.n;
+	}
+
+	const std::uint32_t parallelLevels {parallel && threadPool().size() > 1 ? PARALLEL_DEPTH : 0};
+	const bool padded {PM != N || PK != N || PN != N};
+	const std::size_t workspace {bilinearWorkspace (s, PM, PK, PN, levels, parallelLevels)
+		+ (padded ? Arena::footprint (std::size_t {PM} * PK) + Arena::footprint (std::size_t {PK} * PN) + Arena::footprint (std::size_t {PM} * PN) : 0)};
+
+	Arena & arena = threadArena();
+	Arena::resetHighWater();
+	arena.reserve (workspace);
+	{
+		ArenaScope scope {arena};
+		if (!padded) {
+			bilinearRecurse (s, A.data(), N, B.data(), N, C.data(), N, N, N, N, levels, parallelLevels);
+		} else {
+			ValueType * PA {arena.allocateZeroed (std::size_t {PM} * PK)};
+			ValueType * PB {arena.allocateZeroed (std::size_t {PK} * PN)};
+			ValueType * PC {arena.allocateZeroed (std::size_t {PM} * PN)};
+			for (std::uint32_t i{0}; i < N; ++i) {
+				std::copy_n (A.data() + std::size_t {i} * N, N, PA + std::size_t {i} * PK);
+				std::copy_n (B.data() + std::size_t {i} * N, N, PB + std::size_t {i} * PN);
+			}
+			bilinearRecurse (s, PA, PK, PB, PN, PC, PN, PM, PK, PN, levels, parallelLevels);
+			for (std::uint32_t i{0}; i < N; ++i)
+				for (std::uint32_t j{0}; j < N; ++j)
+					C[i][j] += PC[std::size_t {i} * PN + j];
+		}
+	}
+
+	auto stopTime = std::chrono::high_resolution_clock::now();
+	reportStat ("WORKSPACE RESERVED PER THREAD (KIB):", workspace * sizeof (ValueType) / 1024.0);
+	reportStat ("WORKSPACE HIGH-WATER, ALL THREADS (KIB):", Arena::totalHighWater() * sizeof (ValueType) / 1024.0);
+	return std::chrono::duration_cast <std::chrono::microseconds> (stopTime - startTime).count();
+}
+
+// ********** DIGESTS ********** //
+
+const std::uint64_t PRIME64_1 {0x9E3779B185EBCA87ULL};
+const std::uint64_t PRIME64_2 {0xC2B2AE3D27D4EB4FULL};
+const std::uint64_t PRIME64_3 {0x165667B19E3779F9ULL};
+const std::uint64_t PRIME64_4 {0x85EBCA77C2B2AE63ULL};
+const std::uint64_t PRIME64_5 {0x27D4EB2F165667C5ULL};
+
+inline std::uint64_t rotl64 (std::uint64_t x, std::uint32_t r) {
+	return (x << r) | (x >> (64 - r));
+}
+
+template <typename T>
+inline T readLE (const unsigned char * p) {
+	T value;
+	std::memcpy (&value, p, sizeof (T));
+	return value;
+}
+
+inline std::uint64_t xxhRound (std::uint64_t acc, std::uint64_t input) {
+	return rotl64 (acc + input * PRIME64_2, 31) * PRIME64_1;
+}
+
+inline std::uint64_t xxhMerge (std::uint64_t hash, std::uint64_t acc) {
+	return (hash ^ xxhRound (0, acc)) * PRIME64_1 + PRIME64_4;
+}
+
+std::uint64_t xxh64 (const void * input, std::size_t length, std::uint64_t seed) {
+	const unsigned char * p {static_cast <const unsigned char *> (input)};
+	const unsigned char * const end {p + length};
+	std::uint64_t hash;
+
+	// Four independent lanes over 32-byte stripes
+	if (length >= 32) {
+		std::uint64_t v1 {seed + PRIME64_1 + PRIME64_2}, v2 {seed + PRIME64_2}, v3 {seed}, v4 {seed - PRIME64_1};
+		for (; p + 32 <= end; p += 32) {
+			v1 = xxhRound (v1, readLE <std::uint64_t> (p));
+			v2 = xxhRound (v2, readLE <std::uint64_t> (p + 8));
+			v3 = xxhRound (v3, readLE <std::uint64_t> (p + 16));
+			v4 = xxhRound (v4, readLE <std::uint64_t> (p + 24));
+		}
+		hash = rotl64 (v1, 1) + rotl64 (v2, 7) + rotl64 (v3, 12) + rotl64 (v4, 18);
+		hash = xxhMerge (xxhMerge (xxhMerge (xxhMerge (hash, v1), v2), v3), v4);
+	} else {
+		hash = seed + PRIME64_5;
+	}
+	hash += length;
+
+	for (; p + 8 <= end; p += 8)
+		hash = rotl64 (hash ^ xxhRound (0, readLE <std::uint64_t> (p)), 27) * PRIME64_1 + PRIME64_4;
+	if (p + 4 <= end) {
+		hash = rotl64 (hash ^ (readLE <std::uint32_t> (p) * PRIME64_1), 23) * PRIME64_2 + PRIME64_3;
+		p += 4;
+	}
+	for (; p < end; ++p)
+		hash = rotl64 (hash ^ (*p * PRIME64_5), 11) * PRIME64_1;
+
+	hash ^= hash >> 33;
+	hash *= PRIME64_2;
+	hash ^= hash >> 29;
+	hash *= PRIME64_3;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+// Chunks of DIGEST_CHUNK elements are hashed independently (in parallel for
+// large matrices) and their hashes hashed again, so the digest does not depend
+// on the number of threads
+std::uint64_t matrixDigest (const Matrix2x2 & C) {
+	const std::size_t elements {C.num_elements()};
+	const std::uint32_t chunks (elements / DIGEST_CHUNK + 1);
+	std::vector <std::uint64_t> hashes (chunks);
+	auto hashChunks = [&] (std::uint32_t lo, std::uint32_t hi) {
+		for (std::uint32_t chunk{lo}; chunk < hi; ++chunk) {
+			const std::size_t begin {std::size_t {chunk} * DIGEST_CHUNK};
+			const std::size_t count {std::min <std::size_t> (DIGEST_CHUNK, elements - begin)};
+			hashes[chunk] = xxh64 (C.data() + begin, count * sizeof (ValueType), chunk);
+		}
+	};
+	if (elements >= DIGEST_PARALLEL_MIN)
+		parallelFor (chunks, hashChunks);
+	else
+		hashChunks (0, chunks);
+	return xxh64 (hashes.data(), hashes.size() * sizeof (std::uint64_t), elements);
+}
+
+std::string toHex (std::uint64_t value) {
+	std::ostringstream oss;
+	oss << std::hex << std::setw (16) << std::setfill ('0') << value;
+	return oss.str();
+}
+
+// ********** GOLDEN RESULTS ********** //
+
+GoldenResult summarize (const Matrix2x2 & C) {
+	const std::uint32_t N (C.shape()[0]);
+	GoldenResult result {matrixDigest (C), std::vector <std::int64_t> (N), std::vector <std::int64_t> (N)};
+	for (std::uint32_t i{0}; i < N; ++i)
+		for (std::uint32_t j{0}; j < N; ++j) {
+			result.rowSums[i] += C[i][j];
+			result.colSums[j] += C[i][j];
+		}
+	return result;
+}
+
+GoldenResult goldenResult (const std::string & key, const Matrix2x2 & A, const Matrix2x2 & B, const std::uint32_t N) {
+	const std::string path {GOLDEN_CACHE + "/golden-" + key + ".txt"};
+	GoldenResult golden;
+	std::ifstream in {path};
+	std::string digest;
+	if (in >> digest) {
+		// A corrupt entry is a cache miss, recomputed and overwritten below
+		try {
+			std::size_t parsed {0};
+			golden.digest = std::stoull (digest, &parsed, 16);
+			golden.rowSums.resize (N);
+			golden.colSums.resize (N);
+			for (auto & sum : golden.rowSums)
+				in >> sum;
+			for (auto & sum : golden.colSums)
+				in >> sum;
+			if (in && parsed == digest.size())
+				return golden;
+		} catch (std::logic_error &) {
+		}
+	}
+
+	Matrix2x2 C {boost::extents[N][N]};
+	multiply <'i', 'k', 'j'> (A, B, C, N);
+	golden = summarize (C);
+	std::ofstream out {path};
+	out << toHex (golden.digest) << '\n';
+	for (auto sum : golden.rowSums)
+		out << sum << ' ';
+	out << '\n';
+	for (auto sum : golden.colSums)
+		out << sum << ' ';
+	out << '\n';
+	if (!out)
+		std::cerr << "could not write golden result: " << path << std::endl;
+	return golden;
+}
+
+std::string verify (const GoldenResult & golden, const Matrix2x2 & C) {
+	if (matrixDigest (C) == golden.digest)
+		return "ok";
+	const GoldenResult actual {summarize (C)};
+	const auto row = std::mismatch (std::begin (golden.rowSums), std::end (golden.rowSums), std::begin (actual.rowSums));
+	const auto col = std::mismatch (std::begin (golden.colSums), std::end (golden.colSums), std::begin (actual.colSums));
+	if (row.first != std::end (golden.rowSums) && col.first != std::end (golden.colSums))
+		return "bad " + std::to_string (row.first - std::begin (golden.rowSums))
+			+ "," + std::to_string (col.first - std::begin (golden.colSums));
+	return "MISMATCH";
+}
+
+// ********** CHAIN PRODUCTS ********** //
+
+template <bool Fused>
+std::uint64_t multiplyChain (const Matrix2x2 & A, const Matrix2x2 & B, Matrix2x2 & C, const std::uint32_t N) {
+	static std::map <std::uint32_t, Matrix2x2> operands;
+	if (!operands.count (N)) {
+		EngineType eng {SEED + 1};
+		DistributionType dist {MIN_VALUE, MAX_VALUE};
+		Matrix2x2 & E = operands.emplace (N, Matrix2x2 {boost::extents[N][N]}).first->second;
+		std::generate_n (E.data(), E.num_elements(), std::bind (dist, eng));
+	}
+	const Matrix2x2 & E = operands.at (N);
+	const std::uint32_t rows {Fused
+		? std::max <std::uint32_t> (1, std::min <std::uint32_t> (N, CHAIN_PANEL > 0 ? CHAIN_PANEL : CHAIN_PANEL_BYTES / (N * sizeof (ValueType))))
+		: N};
+
+	Arena & arena = threadArena();
+	arena.reserve (std::size_t {rows} * N);
+	ArenaScope scope {arena};
+	ValueType * T {arena.allocate (std::size_t {rows} * N)};
+
+	auto startTime = std::chrono::high_resolution_clock::now();
+	for (std::uint32_t row{0}; row < N; row += rows) {
+		const std::uint32_t count {std::min (rows, N - row)};
+		std::fill_n (T, std::size_t {count} * N, 0);
+		multiplyBlock (A.data() + std::size_t {row} * N, N, B.data(), N, T, N, count, N, N);
+		multiplyBlock (T, N, E.data(), N, C.data() + std::size_t {row} * N, N, count, N, N);
+	}
+	auto stopTime = std::chrono::high_resolution_clock::now();
+
+	// Unfused, the N x N intermediate is written once and read back once
+	reportStat ("CHAIN PANEL ROWS:", rows);
+	reportStat ("CHAIN TRAFFIC SAVED (MIB):", Fused ? 2.0 * N * N * sizeof (ValueType) / (1024 * 1024) : 0);
+	return std::chrono::duration_cast <std::chrono::microseconds> (stopTime - startTime).count();
+}
+
+// ********** SPLIT-K ********** //
+
+std::uint64_t multiplySplitK (const Matrix2x2 & A, const Matrix2x2 & B, Matrix2x2 & C, const std::uint32_t N) {
+	ThreadPool & pool = threadPool();
+	const std::uint32_t slices {std::max <std::uint32_t> (1, std::min (pool.size(), N))};
+	const std::size_t elements {std::size_t {N} * N};
+
+	Arena & arena = threadArena();
+	arena.reserve (slices * Arena::footprint (elements));
+	ArenaScope scope {arena};
+	std::vector <ValueType *> partial (slices);
+	for (auto & buffer : partial)
+		buffer = arena.allocate (elements);
+
+	auto startTime = std::chrono::high_resolution_clock::now();
+	TaskGroup group {pool};
+	for (std::uint32_t slice{0}; slice < slices; ++slice)
+		group.run ([&, slice] {
+			const std::uint32_t k0 (std::uint64_t {N} * slice / slices), k1 (std::uint64_t {N} * (slice + 1) / slices);
+			std::fill_n (partial[slice], elements, 0);
+			multiplyBlock (A.data() + k0, N, B.data() + std::size_t {k0} * N, N, partial[slice], N, N, k1 - k0, N);
+		});
+	group.wait();
+	auto reduceTime = std::chrono::high_resolution_clock::now();
+
+	if (SPLITK_REDUCE == "atomic") {
+		// Every partial is added straight into C
+		for (std::uint32_t slice{0}; slice < slices; ++slice)
+			group.run ([&, slice] {
+				ValueType * c {C.data()};
+				for (std::size_t e{0}; e < elements; ++e)
+					__atomic_fetch_add (c + e, partial[slice][e], __ATOMIC_RELAXED);
+			});
+		group.wait();
+	} else if (SPLITK_REDUCE == "ring") {
+		// Reduce-scatter: in step t, slice s adds segment (s - t - 1) of its left
+		// neighbour into its own, so after slices - 1 steps slice s holds the
+		// full sum of segment (s + 1), which it adds into C
+		auto segment = [&] (std::uint32_t g, std::uint32_t edge) {
+			return elements * ((g + slices) % slices + edge) / slices;
+		};
+		for (std::uint32_t step{0}; step + 1 < slices; ++step) {
+			for (std::uint32_t slice{0}; slice < slices; ++slice)
+				group.run ([&, step, slice] {
+					const std::uint32_t g {(slice + slices - step - 1) % slices};
+					addInto (partial[slice] + segment (g, 0), partial[(slice + slices - 1) % slices] + segment (g, 0), segment (g, 1) - segment (g, 0));
+				});
+			group.wait();
+		}
+		for (std::uint32_t slice{0}; slice < slices; ++slice)
+			group.run ([&, slice] {
+				const std::uint32_t g {(slice + 1) % slices};
+				addInto (C.data() + segment (g, 0), partial[slice] + segment (g, 0), segment (g, 1) - segment (g, 0));
+			});
+		group.wait();
+	} else {
+		// Pairwise tree: in round r, slice s absorbs slice s + 2^r
+		for (std::uint32_t stride{1}; stride < slices; stride *= 2) {
+			for (std::uint32_t slice{0}; slice + stride < slices; slice += 2 * stride)
+				group.run ([&, slice, stride] {
+					addInto (partial[slice], partial[slice + stride], elements);
+				});
+			group.wait();
+		}
+		parallelFor (N, [&] (std::uint32_t lo, std::uint32_t hi) {
+			addInto (C.data() + std::size_t {lo} * N, partial[0] + std::size_t {lo} * N, std::size_t {hi - lo} * N);
+		});
+	}
+	auto stopTime = std::chrono::high_resolution_clock::now();
+
+	reportStat ("SPLIT-K COMPUTE (MICROSECONDS):", std::chrono::duration_cast <std::chrono::microseconds> (reduceTime - startTime).count());
+	reportStat ("SPLIT-K REDUCTION (MICROSECONDS):", std::chrono::duration_cast <std::chrono::microseconds> (stopTime - reduceTime).count());
+	return std::chrono::duration_cast <std::chrono::microseconds> (stopTime - startTime).count();
+}
+
+// ********** ACCUMULATOR WIDTH ********** //
+
+std::uint32_t accumulatorBits (std::int64_t aMin, std::int64_t aMax, std::int64_t bMin, std::int64_t bMax, std::uint32_t K) {
+	// Every sum of K products lies in [K * smallest product, K * largest product],
+	// bounded in WideType so that it cannot overflow itself
+	const WideType corners[] {WideType {aMin} * bMin, WideType {aMin} * bMax, WideType {aMax} * bMin, WideType {aMax} * bMax};
+	const WideType lo {std::min <WideType> (0, *std::min_element (std::begin (corners), std::end (corners))) * K};
+	const WideType hi {std::max <WideType> (0, *std::max_element (std::begin (corners), std::end (corners))) * K};
+	auto fits = [&] (WideType min, WideType max) {
+		return min <= std::min ({WideType {aMin}, WideType {bMin}, lo}) && std::max ({WideType {aMax}, WideType {bMax}, hi}) <= max;
+	};
+	if (fits (std::numeric_limits <std::int16_t>::min(), std::numeric_limits <std::int16_t>::max()))
+		return 16;
+	if (fits (std::numeric_limits <std::int32_t>::min(), std::numeric_limits <std::int32_t>::max()))
+		return 32;
+	if (fits (std::numeric_limits <std::int64_t>::min(), std::numeric_limits <std::int64_t>::max()))
+		return 64;
+	return 128;
+}
+
+// Copies A and B into T and multiplies them with a row of T accumulators, so
+// narrower types get proportionally more SIMD lanes
+template <typename T>
+void multiplyWidth (const Matrix2x2 & A, const Matrix2x2 & B, Matrix2x2 & C, const std::uint32_t N) {
+	const std::size_t elements {std::size_t {N} * N};
+	std::vector <T> a (A.data(), A.data() + elements), b (B.data(), B.data() + elements), c (N);
+	for (std::uint32_t i{0}; i < N; ++i) {
+		std::fill (std::begin (c), std::end (c), 0);
+		for (std::uint32_t k{0}; k < N; ++k) {
+			const T scale {a[std::size_t {i} * N + k]};
+			const T * __restrict__ row {b.data() + std::size_t {k} * N};
+			for (std::uint32_t j{0}; j < N; ++j)
+				c[j] += scale * row[j];
+		}
+		for (std::uint32_t j{0}; j < N; ++j)
+			C[i][j] += static_cast <ValueType> (c[j]);
+	}
+}
+
+std::uint64_t multiplyAutoWidth (const Matrix2x2 & A, const Matrix2x2 & B, Matrix2x2 & C, const std::uint32_t N) {
+	auto startTime = std::chrono::high_resolution_clock::now();
+	const auto a = std::minmax_element (A.data(), A.data() + A.num_elements());
+	const auto b = std::minmax_element (B.data(), B.data() + B.num_elements());
+	const std::uint32_t bits {accumulatorBits (*a.first, *a.second, *b.first, *b.second, N)};
+	if (bits == 16)
+		multiplyWidth <std::int16_t> (A, B, C, N);
+	else if (bits == 32)
+		multiplyWidth <std::int32_t> (A, B, C, N);
+	else if (bits == 64)
+		multiplyWidth <std::int64_t> (A, B, C, N);
+	else
+		multiplyWidth <WideType> (A, B, C, N);
+	auto stopTime = std::chrono::high_resolution_clock::now();
+	reportStat ("ACCUMULATOR BITS:", bits);
+	return std::chrono::duration_cast <std::chrono::microseconds> (stopTime - startTime).count();
+}
+
+template <typename T>
+std::uint64_t multiplyFixedWidth (const Matrix2x2 & A, const Matrix2x2 & B, Matrix2x2 & C, const std::uint32_t N) {
+	auto startTime = std::chrono::high_resolution_clock::now();
+	multiplyWidth <T> (A, B, C, N);
+	auto stopTime = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration_cast <std::chrono::microseconds> (stopTime - startTime).count();
+}
+
+// ********** MULTI-MODULAR ********** //
+
+// Primes below 2^26: a product of residues is below 2^52, so CRT_BLOCK of them
+// can be summed in 64 bits before reducing. Their product (about 2^104) covers
+// every sum of up to 2^32 products of 32-bit values.
+const std::uint32_t CRT_PRIMES[] {67108859, 67108837, 67108819, 67108777};
+const std::uint32_t CRT_BLOCK {4096};
+
+std::uint64_t powMod (std::uint64_t base, std::uint64_t exponent, std::uint64_t modulus) {
+	std::uint64_t result {1};
+	for (base %= modulus; exponent > 0; exponent >>= 1, base = base * base % modulus)
+		if (exponent & 1)
+			result = result * base % modulus;
+	return result;
+}
+
+// R = A * B mod p on residues, reducing the 64-bit row accumulators every CRT_BLOCK steps of k
+void multiplyModular (const std::uint32_t * A, const std::uint32_t * B, std::uint32_t * R, const std::uint32_t N, const std::uint32_t p) {
+	std::vector <std::uint64_t> acc (N);
+	for (std::uint32_t i{0}; i < N; ++i) {
+		std::fill (std::begin (acc), std::end (acc), 0);
+		for (std::uint32_t k0{0}; k0 < N; k0 += CRT_BLOCK) {
+			for (std::uint32_t k{k0}; k < std::min (N, k0 + CRT_BLOCK); ++k) {
+				const std::uint64_t a {A[std::size_t {i} * N + k]};
+				const std::uint32_t * __restrict__ b {B + std::size_t {k} * N};
+				std::uint64_t * __restrict__ c {acc.data()};
+				for (std::uint32_t j{0}; j < N; ++j)
+					c[j] += a * b[j];
+			}
+			for (auto & value : acc)
+				value %= p;
+		}
+		std::copy (std::begin (acc), std::end (acc), R + std::size_t {i} * N);
+	}
+}
+
+std::uint64_t multiplyCRT (const Matrix2x2 & A, const Matrix2x2 & B, Matrix2x2 & C, const std::uint32_t N) {
+	const std::uint32_t primes {sizeof (CRT_PRIMES) / sizeof (CRT_PRIMES[0])};
+	const std::size_t elements {std::size_t {N} * N};
+
+	// Garner: inverse[s][t] = p_s^-1 mod p_t
+	std::uint64_t inverse[primes][primes];
+	for (std::uint32_t s{0}; s < primes; ++s)
+		for (std::uint32_t t{s + 1}; t < primes; ++t)
+			inverse[s][t] = powMod (CRT_PRIMES[s], CRT_PRIMES[t] - 2, CRT_PRIMES[t]);
+	WideType modulus {1};
+	for (auto p : CRT_PRIMES)
+		modulus *= p;
+
+	auto startTime = std::chrono::high_resolution_clock::now();
+	std::vector <std::vector <std::uint32_t>> residues (primes, std::vector <std::uint32_t> (elements));
+	TaskGroup group {threadPool()};
+	for (std::uint32_t t{0}; t < primes; ++t)
+		group.run ([&, t] {
+			const std::int64_t p {CRT_PRIMES[t]};
+			std::vector <std::uint32_t> a (elements), b (elements);
+			for (std::size_t e{0}; e < elements; ++e) {
+				a[e] = static_cast <std::uint32_t> ((A.data()[e] % p + p) % p);
+				b[e] = static_cast <std::uint32_t> ((B.data()[e] % p + p) % p);
+			}
+			multiplyModular (a.data(), b.data(), residues[t].data(), N, CRT_PRIMES[t]);
+		});
+	group.wait();
+
+	std::uint64_t overflowed {0};
+	for (std::size_t e{0}; e < elements; ++e) {
+		std::uint64_t v[primes];
+		for (std::uint32_t t{0}; t < primes; ++t) {
+			v[t] = residues[t][e];
+			for (std::uint32_t s{0}; s < t; ++s)
+				v[t] = (v[t] + CRT_PRIMES[t] - v[s] % CRT_PRIMES[t]) * inverse[s][t] % CRT_PRIMES[t];
+		}
+		WideType exact {0};
+		for (std::uint32_t t{primes}; t-- > 0;)
+			exact = exact * CRT_PRIMES[t] + v[t];
+		if (exact > modulus / 2)
+			exact -= modulus;
+		overflowed += exact < std::numeric_limits <ValueType>::min() || exact > std::numeric_limits <ValueType>::max();
+		C.data()[e] += static_cast <ValueType> (exact);
+	}
+	auto stopTime = std::chrono::high_resolution_clock::now();
+
+	reportStat ("ELEMENTS OVERFLOWING VALUETYPE:", overflowed);
+	return std::chrono::duration_cast <std::chrono::microseconds> (stopTime - startTime).count();
+}
+
+// ********** OZAKI SCHEME ********** //
+
+// fp64 operands derived from A and B by adding a random fraction to every
+// element, with their product accumulated in long double as the reference
+struct FloatOperands {
+	std::vector <double> A, B, reference;
+};
+
+const FloatOperands & floatOperands (const Matrix2x2 & A, const Matrix2x2 & B, const std::uint32_t N) {
+	static std::map <std::uint32_t, FloatOperands> operands;
+	auto found = operands.find (N);
+	if (found != std::end (operands))
+		return found->second;
+
+	const std::size_t elements {std::size_t {N} * N};
+	FloatOperands & result = operands[N];
+	EngineType eng {SEED + 2};
+	std::uniform_real_distribution <double> fraction {0.0, 1.0};
+	result.A.resize (elements);
+	result.B.resize (elements);
+	for (std::size_t e{0}; e < elements; ++e)
+		result.A[e] = A.data()[e] + fraction (eng);
+	for (std::size_t e{0}; e < elements; ++e)
+		result.B[e] = B.data()[e] + fraction (eng);
+
+	std::vector <long double> row (N);
+	result.reference.resize (elements);
+	for (std::uint32_t i{0}; i < N; ++i) {
+		std::fill (std::begin (row), std::end (row), 0.0L);
+		for (std::uint32_t k{0}; k < N; ++k)
+			for (std::uint32_t j{0}; j < N; ++j)
+				row[j] += static_cast <long double> (result.A[std::size_t {i} * N + k]) * result.B[std::size_t {k} * N + j];
+		std::copy (std::begin (row), std::end (row), std::begin (result.reference) + std::size_t {i} * N);
+	}
+	return result;
+}
+
+// Reports the decimal digits of the largest error relative to the largest
+// reference element, and adds the rounded product into C
+void finishFloat (const std::vector <double> & product, const FloatOperands & operands, Matrix2x2 & C) {
+	double error {0.0}, magnitude {0.0};
+	for (std::size_t e{0}; e < product.size(); ++e) {
+		error = std::max (error, static_cast <double> (std::fabs (product[e] - operands.reference[e])));
+		magnitude = std::max (magnitude, static_cast <double> (std::fabs (operands.reference[e])));
+		C.data()[e] += static_cast <ValueType> (std::llround (product[e]));
+	}
+	reportStat ("CORRECT DIGITS:", error > 0.0 ? -std::log10 (error / magnitude) : std::numeric_limits <double>::digits10 + 1);
+}
+
+std::uint64_t multiplyDouble (const Matrix2x2 & A, const Matrix2x2 & B, Matrix2x2 & C, const std::uint32_t N) {
+	const FloatOperands & operands = floatOperands (A, B, N);
+	std::vector <double> product (std::size_t {N} * N);
+
+	auto startTime = std::chrono::high_resolution_clock::now();
+	for (std::uint32_t i{0}; i < N; ++i)
+		for (std::uint32_t k{0}; k < N; ++k) {
+			const double a {operands.A[std::size_t {i} * N + k]};
+			const double * __restrict__ b {operands.B.data() + std::size_t {k} * N};
+			double * __restrict__ c {product.data() + std::size_t {i} * N};
+			for (std::uint32_t j{0}; j < N; ++j)
+				c[j] += a * b[j];
+		}
+	auto stopTime = std::chrono::high_resolution_clock::now();
+
+	finishFloat (product, operands, C);
+	return std::chrono::duration_cast <std::chrono::microseconds> (stopTime - startTime).count();
+}
+
+// Splits X into slices of OZAKI_SLICE_BITS-bit integers so that
+//   X[i][j] ~= sum over s of slices[s][i][j] * 2^(exponents[i or j] - OZAKI_SLICE_BITS * (s + 1)),
+// sharing one exponent per row (or per column), so every step is exact in double
+void ozakiSplit (const std::vector <double> & X, const std::uint32_t N, const bool byRow,
+	std::vector <std::vector <ValueType>> & slices, std::vector <int> & exponents) {
+	const std::size_t elements {std::size_t {N} * N};
+	std::vector <double> largest (N, 0.0);
+	for (std::size_t e{0}; e < elements; ++e) {
+		double & maximum = largest[byRow ? e / N : e % N];
+		maximum = std::max (maximum, std::fabs (X[e]));
+	}
+	exponents.resize (N);
+	for (std::uint32_t i{0}; i < N; ++i)
+		exponents[i] = largest[i] > 0.0 ? std::ilogb (largest[i]) + 1 : 0;
+
+	slices.assign (OZAKI_SLICES, std::vector <ValueType> (elements));
+	for (std::size_t e{0}; e < elements; ++e) {
+		double remainder {std::ldexp (X[e], -exponents[byRow ? e / N : e % N])};
+		for (std::uint32_t s{0}; s < OZAKI_SLICES; ++s) {
+			remainder = std::ldexp (remainder, OZAKI_SLICE_BITS);
+			const double digit {std::trunc (remainder)};
+			slices[s][e] = static_cast <ValueType> (digit);
+			remainder -= digit;
+		}
+	}
+}
+
+std::uint64_t multiplyOzaki (const Matrix2x2 & A, const Matrix2x2 & B, Matrix2x2 & C, const std::uint32_t N) {
+	const FloatOperands & operands = floatOperands (A, B, N);
+	const std::size_t elements {std::size_t {N} * N};
+	std::vector <double> product (elements);
+
+	auto startTime = std::chrono::high_resolution_clock::now();
+	std::vector <std::vector <ValueType>> sliceA, sliceB;
+	std::vector <int> rowExponents, colExponents;
+	ozakiSplit (operands.A, N, true, sliceA, rowExponents);
+	ozakiSplit (operands.B, N, false, sliceB, colExponents);
+
+	// Products of equal weight (s + t == d) share one exact integer sum; pairs
+	// with s + t >= OZAKI_SLICES are below the precision of the slicing and skipped
+	std::vector <ValueType> partial (elements);
+	for (std::uint32_t d{OZAKI_SLICES}; d-- > 0;) {
+		std::fill (std::begin (partial), std::end (partial), 0);
+		for (std::uint32_t s{0}; s <= d; ++s)
+			multiplyBlock (sliceA[s].data(), N, sliceB[d - s].data(), N, partial.data(), N, N, N, N);
+		const int weight {-static_cast <int> (OZAKI_SLICE_BITS * (d + 2))};
+		for (std::uint32_t i{0}; i < N; ++i)
+			for (std::uint32_t j{0}; j < N; ++j)
+				product[std::size_t {i} * N + j] += std::ldexp (static_cast <double> (partial[std::size_t {i} * N + j]),
+					weight + rowExponents[i] + colExponents[j]);
+	}
+	auto stopTime = std::chrono::high_resolution_clock::now();
+
+	finishFloat (product, operands, C);
+	return std::chrono::duration_cast <std::chrono::microseconds> (stopTime - startTime).count();
+}
+
+// ********** FAULT TOLERANCE ********** //
+
+std::uint64_t multiplyABFT (const FunctionType & kernel, const Matrix2x2 & A, const Matrix2x2 & B, Matrix2x2 & C, const std::uint32_t N) {
+	// The unprotected N x N product, best of three warm runs, is the baseline of the overhead
+	Matrix2x2 plainC {boost::extents[N][N]};
+	std::uint64_t plainTime {std::numeric_limits <std::uint64_t>::max()};
+	for (std::uint32_t run{0}; run < 3; ++run) {
+		std::fill_n (plainC.data(), plainC.num_elements(), 0);
+		plainTime = std::min (plainTime, kernel (A, B, plainC, N));
+	}
+
+	auto startTime = std::chrono::high_resolution_clock::now();
+
+	// Checksums wrap like the product itself, so they are kept unsigned
+	Matrix2x2 checkedA {boost::extents[N + 1][N + 1]}, checkedB {boost::extents[N + 1][N + 1]}, checkedC {boost::extents[N + 1][N + 1]};
+	for (std::uint32_t i{0}; i < N; ++i) {
+		std::uint32_t rowSum {0};
+		for (std::uint32_t j{0}; j < N; ++j) {
+			checkedA[i][j] = A[i][j];
+			checkedA[N][j] = static_cast <std::uint32_t> (checkedA[N][j]) + static_cast <std::uint32_t> (A[i][j]);
+			checkedB[i][j] = B[i][j];
+			rowSum += static_cast <std::uint32_t> (B[i][j]);
+		}
+		checkedB[i][N] = static_cast <ValueType> (rowSum);
+	}
+
+	kernel (checkedA, checkedB, checkedC, N + 1);
+
+	EngineType eng {SEED + 3};
+	std::uniform_int_distribution <std::uint32_t> position {0, N - 1};
+	for (std::uint32_t fault{0}; fault < INJECT_FAULTS; ++fault)
+		checkedC[position (eng)][position (eng)] ^= 1 << (fault % 31);
+
+	std::vector <std::uint32_t> rowError (N), colError (N);
+	for (std::uint32_t i{0}; i < N; ++i)
+		for (std::uint32_t j{0}; j < N; ++j) {
+			rowError[i] += static_cast <std::uint32_t> (checkedC[i][j]);
+			colError[j] += static_cast <std::uint32_t> (checkedC[i][j]);
+		}
+	std::vector <std::uint32_t> badRows, badCols;
+	for (std::uint32_t i{0}; i < N; ++i) {
+		if (rowError[i] -= static_cast <std::uint32_t> (checkedC[i][N]))
+			badRows.push_back (i);
+		if (colError[i] -= static_cast <std::uint32_t> (checkedC[N][i]))
+			badCols.push_back (i);
+	}
+	// One bad row and one bad column disagreeing by the same amount locate a single error
+	const bool correctable {badRows.size() == 1 && badCols.size() == 1 && rowError[badRows[0]] == colError[badCols[0]]};
+	if (correctable)
+		checkedC[badRows[0]][badCols[0]] = static_cast <std::uint32_t> (checkedC[badRows[0]][badCols[0]]) - rowError[badRows[0]];
+
+	for (std::uint32_t i{0}; i < N; ++i)
+		for (std::uint32_t j{0}; j < N; ++j)
+			C[i][j] += checkedC[i][j];
+	auto stopTime = std::chrono::high_resolution_clock::now();
+
+	const std::uint64_t totalTime = std::chrono::duration_cast <std::chrono::microseconds> (stopTime - startTime).count();
+	reportStat ("CHECKSUM MISMATCHES:", std::max (badRows.size(), badCols.size()));
+	reportStat ("CORRECTED ELEMENTS:", correctable);
+	reportStat ("ABFT OVERHEAD (%):", plainTime ? 100.0 * (static_cast <double> (totalTime) - plainTime) / plainTime : 0.0);
+	return totalTime;
+}
+
+// ********** APPROXIMATE PRODUCTS ********** //
+
+// Rank of the approximation: enough samples for an expected Frobenius error of
+// EPSILON |A|_F |B|_F unless APPROX_RANK is given
+std::uint32_t approxRank (const std::uint32_t N) {
+	const double rank {APPROX_RANK > 0 ? APPROX_RANK : std::ceil (1.0 / (EPSILON * EPSILON))};
+	return static_cast <std::uint32_t> (std::max (1.0, std::min <double> (N, rank)));
+}
+
+// Exact product of A and B and the time the strided kernel took for it
+struct ExactProduct {
+	std::vector <ValueType> C;
+	std::uint64_t time;
+};
+
+const ExactProduct & exactProduct (const Matrix2x2 & A, const Matrix2x2 & B, const std::uint32_t N) {
+	static std::map <std::uint32_t, ExactProduct> products;
+	auto found = products.find (N);
+	if (found != std::end (products))
+		return found->second;
+
+	ExactProduct & result = products[N];
+	result.C.assign (std::size_t {N} * N, 0);
+	auto startTime = std::chrono::high_resolution_clock::now();
+	multiplyBlock (A.data(), N, B.data(), N, result.C.data(), N, N, N, N);
+	auto stopTime = std::chrono::high_resolution_clock::now();
+	result.time = std::chrono::duration_cast <std::chrono::microseconds> (stopTime - startTime).count();
+	return result;
+}
+
+// Reports the Frobenius error of product against A * B and the speedup over
+// computing A * B exactly, and adds the rounded product into C
+template <typename T>
+void finishApproximate (const std::vector <T> & product, const Matrix2x2 & A, const Matrix2x2 & B, Matrix2x2 & C,
+	const std::uint32_t N, const std::uint64_t time) {
+	const ExactProduct & exact = exactProduct (A, B, N);
+	double error {0.0}, norm {0.0};
+	for (std::size_t e{0}; e < product.size(); ++e) {
+		error += (product[e] - static_cast <double> (exact.C[e])) * (product[e] - static_cast <double> (exact.C[e]));
+		norm += static_cast <double> (exact.C[e]) * exact.C[e];
+		C.data()[e] += static_cast <ValueType> (std::llround (product[e]));
+	}
+	reportStat ("RELATIVE FROBENIUS ERROR (%):", norm > 0.0 ? 100.0 * std::sqrt (error / norm) : 0.0);
+	reportStat ("SPEEDUP OVER EXACT:", static_cast <double> (exact.time) / std::max <std::uint64_t> (time, 1));
+}
+
+std::uint64_t multiplySampled (const Matrix2x2 & A, const Matrix2x2 & B, Matrix2x2 & C, const std::uint32_t N) {
+	const std::uint32_t rank {approxRank (N)};
+	std::vector <double> product (std::size_t {N} * N);
+
+	auto startTime = std::chrono::high_resolution_clock::now();
+	std::vector <double> weights (N);
+	for (std::uint32_t k{0}; k < N; ++k) {
+		double column {0.0}, row {0.0};
+		for (std::uint32_t i{0}; i < N; ++i) {
+			column += static_cast <double> (A[i][k]) * A[i][k];
+			row += static_cast <double> (B[k][i]) * B[k][i];
+		}
+		weights[k] = std::sqrt (column * row);
+	}
+	const double total {std::accumulate (std::begin (weights), std::end (weights), 0.0)};
+
+	// Each sample k contributes A[:,k] B[k,:] / (rank p_k), an unbiased estimate of A * B
+	EngineType eng {SEED + 4};
+	std::discrete_distribution <std::uint32_t> sample (std::begin (weights), std::end (weights));
+	std::vector <double> sampledA (std::size_t {N} * rank), sampledB (std::size_t {rank} * N);
+	for (std::uint32_t t{0}; t < rank && total > 0.0; ++t) {
+		const std::uint32_t k {sample (eng)};
+		const double scale {total / (rank * weights[k])};
+		for (std::uint32_t i{0}; i < N; ++i) {
+			sampledA[std::size_t {i} * rank + t] = A[i][k] * scale;
+			sampledB[std::size_t {t} * N + i] = B[k][i];
+		}
+	}
+	for (std::uint32_t i{0}; i < N; ++i)
+		for (std::uint32_t t{0}; t < rank; ++t) {
+			const double a {sampledA[std::size_t {i} * rank + t]};
+			const double * __restrict__ b {sampledB.data() + std::size_t {t} * N};
+			double * __restrict__ c {product.data() + std::size_t {i} * N};
+			for (std::uint32_t j{0}; j < N; ++j)
+				c[j] += a * b[j];
+		}
+	auto stopTime = std::chrono::high_resolution_clock::now();
+
+	const std::uint64_t time = std::chrono::duration_cast <std::chrono::microseconds> (stopTime - startTime).count();
+	finishApproximate (product, A, B, C, N, time);
+	return time;
+}
+
+std::uint64_t multiplySketched (const Matrix2x2 & A, const Matrix2x2 & B, Matrix2x2 & C, const std::uint32_t N) {
+	const std::uint32_t rank {approxRank (N)};
+	std::vector <ValueType> product (std::size_t {N} * N);
+
+	auto startTime = std::chrono::high_resolution_clock::now();
+	// S has a single +-1 in every column: k is hashed to bucket[k] with sign[k]
+	EngineType eng {SEED + 4};
+	std::uniform_int_distribution <std::uint32_t> hash {0, rank - 1};
+	std::vector <std::uint32_t> bucket (N);
+	std::vector <ValueType> sign (N);
+	for (std::uint32_t k{0}; k < N; ++k) {
+		bucket[k] = hash (eng);
+		sign[k] = (eng() & 1) ? 1 : -1;
+	}
+
+	std::vector <ValueType> sketchA (std::size_t {N} * rank), sketchB (std::size_t {rank} * N);
+	for (std::uint32_t i{0}; i < N; ++i)
+		for (std::uint32_t k{0}; k < N; ++k)
+			sketchA[std::size_t {i} * rank + bucket[k]] += sign[k] * A[i][k];
+	for (std::uint32_t k{0}; k < N; ++k) {
+		ValueType * __restrict__ row {sketchB.data() + std::size_t {bucket[k]} * N};
+		for (std::uint32_t j{0}; j < N; ++j)
+			row[j] += sign[k] * B[k][j];
+	}
+	multiplyBlock (sketchA.data(), rank, sketchB.data(), N, product.data(), N, N, rank, N);
+	auto stopTime = std::chrono::high_resolution_clock::now();
+
+	const std::uint64_t time = std::chrono::duration_cast <std::chrono::microseconds> (stopTime - startTime).count();
+	finishApproximate (product, A, B, C, N, time);
+	return time;
+}
+
+// ********** INCREMENTAL UPDATES ********** //
+
+// C += U (V B), the change of A * B when A changes by U V, in O(k N^2)
+void updateLowRank (ValueType * C, const ValueType * U, const ValueType * V, const ValueType * B, const std::uint32_t N, const std::uint32_t k) {
+	std::vector <ValueType> W (std::size_t {k} * N);
+	multiplyBlock (V, N, B, N, W.data(), N, k, N, N);
+	multiplyBlock (U, k, W.data(), N, C, N, N, k, N);
+}
+
+// Recomputes rows[r] of C from their new rows of A in O(d N^2)
+void updateRows (ValueType * C, const std::vector <std::uint32_t> & rows, const ValueType * newRows, const ValueType * B, const std::uint32_t N) {
+	for (std::size_t r{0}; r < rows.size(); ++r) {
+		ValueType * row {C + std::size_t {rows[r]} * N};
+		std::fill (row, row + N, 0);
+		multiplyBlock (newRows + r * N, N, B, N, row, N, 1, N, N);
+	}
+}
+
+// Grows the M x N product C to (M + d) x (N + d) for d rows appended to A and
+// d columns appended to B, in O(d (M + N) K)
+std::vector <ValueType> appendRowsColumns (const std::vector <ValueType> & C, const ValueType * A, const ValueType * B,
+	const ValueType * newRows, const ValueType * newCols, const std::uint32_t M, const std::uint32_t K, const std::uint32_t N, const std::uint32_t d) {
+	const std::uint32_t ldc {N + d};
+	std::vector <ValueType> grown (std::size_t {M + d} * ldc);
+	for (std::uint32_t i{0}; i < M; ++i)
+		std::copy (C.data() + std::size_t {i} * N, C.data() + std::size_t {i + 1} * N, grown.data() + std::size_t {i} * ldc);
+	multiplyBlock (A, K, newCols, d, grown.data() + N, ldc, M, K, d);
+	multiplyBlock (newRows, K, B, N, grown.data() + std::size_t {M} * ldc, ldc, d, K, N);
+	multiplyBlock (newRows, K, newCols, d, grown.data() + std::size_t {M} * ldc + N, ldc, d, K, d);
+	return grown;
+}
+
+std::uint64_t multiplyIncremental (Update update, const Matrix2x2 & A, const Matrix2x2 & B, Matrix2x2 & C, const std::uint32_t N) {
+	const std::vector <ValueType> & previous = exactProduct (A, B, N).C;
+	const std::size_t elements {std::size_t {N} * N};
+	std::uint64_t totalTime {0}, mismatches {0};
+	double largestSpeedup {0.0};
+	std::uint32_t largest {0}, resultCols {N};
+	std::vector <ValueType> result;
+
+	for (std::uint32_t d : DELTAS) {
+		if (d == 0 || d > N)
+			continue;
+		EngineType eng {SEED + 5 + d};
+		DistributionType dist {MIN_VALUE, MAX_VALUE};
+		auto generate = [&] (std::size_t count) {
+			std::vector <ValueType> values (count);
+			std::generate (std::begin (values), std::end (values), std::bind (dist, std::ref (eng)));
+			return values;
+		};
+
+		// The changed operands, which a full recomputation multiplies again
+		std::uint32_t rowsA {N}, colsB {N};
+		std::vector <ValueType> changedA (A.data(), A.data() + elements), changedB (B.data(), B.data() + elements);
+		std::vector <ValueType> updated (previous), recomputed;
+		std::chrono::high_resolution_clock::time_point startTime, stopTime;
+
+		switch (update) {
+		case Update::RANK: {
+			const std::vector <ValueType> U {generate (std::size_t {N} * d)}, V {generate (std::size_t {d} * N)};
+			multiplyBlock (U.data(), d, V.data(), N, changedA.data(), N, N, d, N);
+			startTime = std::chrono::high_resolution_clock::now();
+			updateLowRank (updated.data(), U.data(), V.data(), B.data(), N, d);
+			stopTime = std::chrono::high_resolution_clock::now();
+			break;
+		}
+		case Update::ROWS: {
+			std::vector <std::uint32_t> rows (N);
+			std::iota (std::begin (rows), std::end (rows), 0);
+			std::shuffle (std::begin (rows), std::end (rows), eng);
+			rows.resize (d);
+			const std::vector <ValueType> newRows {generate (std::size_t {d} * N)};
+			for (std::uint32_t r{0}; r < d; ++r)
+				std::copy (newRows.data() + std::size_t {r} * N, newRows.data() + std::size_t {r + 1} * N,
+					changedA.data() + std::size_t {rows[r]} * N);
+			startTime = std::chrono::high_resolution_clock::now();
+			updateRows (updated.data(), rows, newRows.data(), B.data(), N);
+			stopTime = std::chrono::high_resolution_clock::now();
+			break;
+		}
+		case Update::APPEND: {
+			const std::vector <ValueType> newRows {generate (std::size_t {d} * N)}, newCols {generate (std::size_t {N} * d)};
+			changedA.insert (std::end (changedA), std::begin (newRows), std::end (newRows));
+			changedB.resize (std::size_t {N} * (N + d));
+			for (std::uint32_t k{N}; k-- > 0;) {
+				std::copy_backward (B.data() + std::size_t {k} * N, B.data() + std::size_t {k + 1} * N,
+					changedB.data() + std::size_t {k} * (N + d) + N);
+				std::copy (newCols.data() + std::size_t {k} * d, newCols.data() + std::size_t {k + 1} * d,
+					changedB.data() + std::size_t {k} * (N + d) + N);
+			}
+			rowsA = colsB = N + d;
+			startTime = std::chrono::high_resolution_clock::now();
+			updated = appendRowsColumns (previous, A.data(), B.data(), newRows.data(), newCols.data(), N, N, N, d);
+			stopTime = std::chrono::high_resolution_clock::now();
+			break;
+		}
+		}
+		const std::uint64_t updateTime = std::chrono::duration_cast <std::chrono::microseconds> (stopTime - startTime).count();
+
+		recomputed.assign (std::size_t {rowsA} * colsB, 0);
+		startTime = std::chrono::high_resolution_clock::now();
+		multiplyBlock (changedA.data(), N, changedB.data(), colsB, recomputed.data(), colsB, rowsA, N, colsB);
+		stopTime = std::chrono::high_resolution_clock::now();
+		const std::uint64_t recomputeTime = std::chrono::duration_cast <std::chrono::microseconds> (stopTime - startTime).count();
+
+		mismatches += !std::equal (std::begin (updated), std::end (updated), std::begin (recomputed));
+		const double speedup {static_cast <double> (recomputeTime) / std::max <std::uint64_t> (updateTime, 1)};
+		if (d >= largest) {
+			largest = d;
+			largestSpeedup = speedup;
+		}
+		totalTime += updateTime;
+
+		std::ostringstream title;
+		title << "SPEEDUP AT DELTA " << std::setw (4) << d << ':';
+		reportStat (title.str(), speedup);
+		result.swap (updated);
+		resultCols = colsB;
+	}
+
+	// C is the N x N block of the product after the last delta
+	for (std::uint32_t i{0}; i < N && !result.empty(); ++i)
+		for (std::uint32_t j{0}; j < N; ++j)
+			C[i][j] += result[std::size_t {i} * resultCols + j];
+
+	// Update cost grows linearly in d, so the crossover is extrapolated from the
+	// largest delta; N means no crossover below a full recomputation
+	reportStat ("CROSSOVER DELTA (EST.):", std::min <double> (N, largest * largestSpeedup));
+	reportStat ("UPDATE MISMATCHES:", mismatches);
+	return totalTime;
+}
+
+// ********** STREAMING ********** //
+
+// Reads until count bytes arrived or the input ended; returns the bytes read
+std::size_t readFully (int fd, void * buffer, std::size_t count) {
+	std::size_t done {0};
+	while (done < count) {
+		const ssize_t got {::read (fd, static_cast <char *> (buffer) + done, count - done)};
+		if (got == 0)
+			break;
+		if (got < 0 && errno != EINTR)
+			throw std::runtime_error (std::string {"stream read failed: "} + std::strerror (errno));
+		done += std::max <ssize_t> (got, 0);
+	}
+	return done;
+}
+
+// Share of the writer's busy time hidden behind compute, given the time spent
+// waiting for it to drain after the last panel
+double writeOverlap (const PanelWriter & writer, std::chrono::high_resolution_clock::duration drain) {
+	const double busy {std::chrono::duration <double> (writer.busyTime()).count()};
+	return busy > 0.0 ? 100.0 * std::max (0.0, 1.0 - std::chrono::duration <double> (drain).count() / busy) : 100.0;
+}
+
+// Runs step, keeping its runtime error in failure unless one is already kept
+void keepFailure (std::exception_ptr & failure, const std::function <void()> & step) {
+	try {
+		step();
+	} catch (std::runtime_error &) {
+		if (!failure)
+			failure = std::current_exception();
+	}
+}
+
+// Closes a descriptor from openStream, leaving the standard ones open
+void closeStream (int fd) {
+	if (fd > STDERR_FILENO && ::close (fd) < 0)
+		throw std::runtime_error (std::string {"stream close failed: "} + std::strerror (errno));
+}
+
+// Opens a stream path, - being the given standard descriptor
+int openStream (const std::string & path, int flags, int standard) {
+	if (path == "-")
+		return standard;
+	const int fd {::open (path.c_str(), flags, 0644)};
+	if (fd < 0)
+		throw std::runtime_error ("could not open stream: " + path + ": " + std::strerror (errno));
+	return fd;
+}
+
+// Rows of A in flight between the reader and the multiply
+struct Panel {
+	std::vector <ValueType> rows;
+	std::uint32_t count;
+};
+
+std::uint64_t multiplyStream (const Matrix2x2 & A, const Matrix2x2 & B, Matrix2x2 & C, const std::uint32_t N) {
+	using Clock = std::chrono::high_resolution_clock;
+	const std::size_t rowBytes {std::size_t {N} * sizeof (ValueType)};
+	const int output {openStream (STREAM_C.empty() ? "/dev/null" : STREAM_C, O_WRONLY | O_CREAT | O_TRUNC, STDOUT_FILENO)};
+	int input {-1};
+	try {
+		input = STREAM_A.empty() ? -1 : openStream (STREAM_A, O_RDONLY, STDIN_FILENO);
+
+		// Every run streams the input from where the first one started; one that
+		// cannot seek back (a pipe, say, with several sizes) has nothing left
+		static off_t inputStart {-1};
+		static bool streamed {false};
+		if (input >= 0) {
+			const off_t position {::lseek (input, 0, SEEK_CUR)};
+			if (position < 0 && streamed)
+				throw std::runtime_error (STREAM_A + " cannot be read more than once");
+			if (position >= 0 && inputStart < 0)
+				inputStart = position;
+			if (position >= 0 && ::lseek (input, inputStart, SEEK_SET) < 0)
+				throw std::runtime_error (std::string {"stream seek failed: "} + std::strerror (errno));
+			streamed = true;
+		}
+	} catch (std::runtime_error &) {
+		for (int fd : {input, output})
+			if (fd > STDERR_FILENO)
+				::close (fd);
+		throw;
+	}
+
+	Channel <Panel> free {STREAM_BUFFERS}, ready {STREAM_BUFFERS};
+	for (std::uint32_t buffer{0}; buffer < STREAM_BUFFERS; ++buffer)
+		free.push (Panel {std::vector <ValueType> (std::size_t {STREAM_PANEL} * N), 0});
+
+	// A read failure ends the stream early and is rethrown once the reader joins
+	std::exception_ptr failure;
+	auto startTime = Clock::now();
+	std::thread reader {[&] {
+		std::uint32_t next {0};
+		Panel panel;
+		try {
+			while (free.pop (panel)) {
+				if (input < 0) {
+					panel.count = std::min (STREAM_PANEL, N - next);
+					std::copy (A.data() + std::size_t {next} * N, A.data() + std::size_t {next + panel.count} * N, panel.rows.data());
+					next += panel.count;
+				} else {
+					const std::size_t bytes {readFully (input, panel.rows.data(), STREAM_PANEL * rowBytes)};
+					if (bytes % rowBytes != 0)
+						throw std::runtime_error ("stream ended inside a row, " + std::to_string (bytes % rowBytes) + " bytes left over");
+					panel.count = bytes / rowBytes;
+				}
+				if (panel.count == 0)
+					break;
+				ready.push (std::move (panel));
+			}
+		} catch (std::runtime_error &) {
+			failure = std::current_exception();
+		}
+		ready.close();
+	}};
+
+	PanelWriter writer {output, STREAM_BUFFERS, std::size_t {STREAM_PANEL} * N};
+	std::uint64_t rows {0};
+	Clock::duration readStall {0}, writeStall {0};
+	Panel panel;
+	for (;;) {
+		auto waitTime = Clock::now();
+		const bool more {ready.pop (panel)};
+		readStall += Clock::now() - waitTime;
+		if (!more)
+			break;
+
+		waitTime = Clock::now();
+		std::vector <ValueType> product {writer.acquire()};
+		writeStall += Clock::now() - waitTime;
+		std::fill_n (std::begin (product), std::size_t {panel.count} * N, 0);
+		multiplyBlock (panel.rows.data(), N, B.data(), N, product.data(), N, panel.count, N, N);
+		for (std::uint32_t r{0}; r < panel.count && rows + r < N; ++r)
+			std::transform (product.data() + std::size_t {r} * N, product.data() + std::size_t {r + 1} * N,
+				C[rows + r].begin(), C[rows + r].begin(), std::plus <ValueType> {});
+		writer.write (std::move (product), panel.count * rowBytes);
+		rows += panel.count;
+		free.push (std::move (panel));
+	}
+	reader.join();
+	auto drainTime = Clock::now();
+	keepFailure (failure, [&] { writer.finish(); });
+	auto stopTime = Clock::now();
+	writeStall += stopTime - drainTime;
+
+	for (int fd : {input, output})
+		keepFailure (failure, [fd] { closeStream (fd); });
+	if (failure)
+		std::rethrow_exception (failure);
+
+	const double elapsed {std::chrono::duration <double> (stopTime - startTime).count()};
+	reportStat ("STREAMED ROWS PER SECOND:", elapsed > 0.0 ? rows / elapsed : 0.0);
+	reportStat ("READ STALL (%):", elapsed > 0.0 ? 100.0 * std::chrono::duration <double> (readStall).count() / elapsed : 0.0);
+	reportStat ("WRITE STALL (%):", elapsed > 0.0 ? 100.0 * std::chrono::duration <double> (writeStall).count() / elapsed : 0.0);
+	reportStat ("WRITE OVERLAP (%):", writeOverlap (writer, stopTime - drainTime));
+	return std::chrono::duration_cast <std::chrono::microseconds> (stopTime - startTime).count();
+}
+
+std::uint64_t multiplyOutput (const Matrix2x2 & A, const Matrix2x2 & B, Matrix2x2 & C, const std::uint32_t N) {
+	using Clock = std::chrono::high_resolution_clock;
+	const std::size_t rowBytes {std::size_t {N} * sizeof (ValueType)};
+	const int output {openStream (OUTPUT_C.empty() ? "/dev/null" : OUTPUT_C, O_WRONLY | O_CREAT | O_TRUNC, STDOUT_FILENO)};
+
+	// Finished rows of C are final, so the writer borrows them instead of copying
+	auto startTime = Clock::now();
+	PanelWriter writer {output, 0, 0};
+	for (std::uint32_t lo{0}; lo < N; lo += STREAM_PANEL) {
+		const std::uint32_t hi {std::min (N, lo + STREAM_PANEL)};
+		multiplyKernel <'i', 'k', 'j'> (A, B, C, N, lo, hi);
+		writer.write (C[lo].origin(), (hi - lo) * rowBytes);
+	}
+	auto drainTime = Clock::now();
+	std::exception_ptr failure;
+	keepFailure (failure, [&] { writer.finish(); });
+	auto stopTime = Clock::now();
+
+	keepFailure (failure, [output] { closeStream (output); });
+	if (failure)
+		std::rethrow_exception (failure);
+
+	reportStat ("WRITE OVERLAP (%):", writeOverlap (writer, stopTime - drainTime));
+	return std::chrono::duration_cast <std::chrono::microseconds> (stopTime - startTime).count();
+}
+
+// ********** IMPORT ********** //
+
+// File contents followed by eight zero bytes, so eight digits can always be loaded
+std::vector <char> readPadded (const std::string & path) {
+	std::ifstream in {path, std::ios::binary};
+	if (!in)
+		throw std::runtime_error ("could not open matrix: " + path);
+	std::vector <char> text {std::istreambuf_iterator <char> {in}, std::istreambuf_iterator <char> {}};
+	text.resize (text.size() + 8, '\0');
+	return text;
+}
+
+// Value of eight digits (byte values 0-9, first digit in the lowest byte)
+std::uint64_t eightDigits (std::uint64_t chunk) {
+	chunk = (chunk * 10) + (chunk >> 8);
+	return (((chunk & 0x000000FF000000FF) * (100 + (1000000ULL << 32)))
+		+ (((chunk >> 16) & 0x000000FF000000FF) * (1 + (10000ULL << 32)))) >> 32;
+}
+
+// Parses an optionally signed decimal integer at p, up to eight digits per
+// step with SWAR arithmetic on a 64-bit word; nullptr if p holds no digits
+const char * parseInteger (const char * p, ValueType & value) {
+	static const std::uint64_t POWERS[] {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+	const bool negative {*p == '-'};
+	p += negative || *p == '+';
+	std::uint64_t result {0};
+	const char * start {p};
+	for (;;) {
+		std::uint64_t chunk;
+		std::memcpy (&chunk, p, sizeof (chunk));
+		chunk ^= 0x3030303030303030;
+		// A byte is not a digit if its high nibble is set or its low nibble exceeds 9
+		const std::uint64_t other {(chunk & 0xF0F0F0F0F0F0F0F0) | ((chunk + 0x0606060606060606) & 0x1010101010101010)};
+		const std::uint32_t digits {other ? static_cast <std::uint32_t> (__builtin_ctzll (other)) / 8 : 8};
+		if (digits == 0)
+			break;
+		result = result * POWERS[digits] + eightDigits (chunk << (8 * (8 - digits)));
+		p += digits;
+		if (digits < 8)
+			break;
+	}
+	if (p == start)
+		return nullptr;
+	value = static_cast <ValueType> (negative ? -static_cast <std::int64_t> (result) : static_cast <std::int64_t> (result));
+	return p;
+}
+
+const char * skipSeparators (const char * p, const char * end) {
+	while (p < end && (*p == ' ' || *p == '\t' || *p == ',' || *p == '\r'))
+		++p;
+	return p;
+}
+
+bool blankLine (const char * p, const char * end) {
+	return skipSeparators (p, end) == end || *skipSeparators (p, end) == '\n';
+}
+
+// Splits [begin, end) into about pieces chunks that each start at a line
+std::vector <const char *> lineChunks (const char * begin, const char * end, std::uint32_t pieces) {
+	std::vector <const char *> bounds {begin};
+	for (std::uint32_t piece{1}; piece < pieces; ++piece) {
+		const char * p {std::max (bounds.back(), begin + (end - begin) * piece / pieces)};
+		p = std::find (p, end, '\n');
+		bounds.push_back (p == end ? end : p + 1);
+	}
+	bounds.push_back (end);
+	return bounds;
+}
+
+// Runs body (chunk) over the chunks on the pool; rethrows the first failure
+void forEachChunk (std::uint32_t chunks, const std::function <void (std::uint32_t)> & body) {
+	std::vector <std::string> errors (chunks);
+	parallelFor (chunks, [&] (std::uint32_t lo, std::uint32_t hi) {
+		for (std::uint32_t chunk{lo}; chunk < hi; ++chunk)
+			try {
+				body (chunk);
+			} catch (std::runtime_error & ex) {
+				errors[chunk] = ex.what();
+			}
+	}, Schedule::DYNAMIC);
+	for (const auto & error : errors)
+		if (!error.empty())
+			throw std::runtime_error (error);
+}
+
+// Dense rows of comma or whitespace separated integers, with an optional header line
+void parseCSV (const char * begin, const char * end, Matrix2x2 & M) {
+	const char * lineEnd {std::find (begin, end, '\n')};
+	ValueType value;
+	if (!parseInteger (skipSeparators (begin, lineEnd), value))
+		begin = std::min (end, lineEnd + 1);
+
+	std::uint32_t cols {0};
+	lineEnd = std::find (begin, end, '\n');
+	for (const char * p {skipSeparators (begin, lineEnd)}; p < lineEnd && (p = parseInteger (p, value)); p = skipSeparators (p, lineEnd))
+		++cols;
+
+	// First count the rows of every chunk to know where its rows land
+	const std::vector <const char *> bounds {lineChunks (begin, end, 4 * THREADS)};
+	const std::uint32_t chunks = bounds.size() - 1;
+	std::vector <std::uint32_t> firstRow (chunks + 1);
+	forEachChunk (chunks, [&] (std::uint32_t chunk) {
+		for (const char * line {bounds[chunk]}; line < bounds[chunk + 1]; line = std::find (line, bounds[chunk + 1], '\n') + 1)
+			firstRow[chunk + 1] += !blankLine (line, bounds[chunk + 1]);
+	});
+	std::partial_sum (std::begin (firstRow), std::end (firstRow), std::begin (firstRow));
+
+	M.resize (boost::extents[firstRow[chunks]][cols]);
+	forEachChunk (chunks, [&] (std::uint32_t chunk) {
+		std::uint32_t row {firstRow[chunk]};
+		for (const char * line {bounds[chunk]}; line < bounds[chunk + 1]; line = std::find (line, bounds[chunk + 1], '\n') + 1) {
+			if (blankLine (line, bounds[chunk + 1]))
+				continue;
+			const char * p {line};
+			for (std::uint32_t col{0}; col < cols; ++col)
+				if (!(p = parseInteger (skipSeparators (p, end), M[row][col])))
+					throw std::runtime_error ("expected " + std::to_string (cols) + " integers in row " + std::to_string (row + 1));
+			if (!blankLine (p, end))
+				throw std::runtime_error ("more than " + std::to_string (cols) + " integers in row " + std::to_string (row + 1));
+			++row;
+		}
+	});
+}
+
+// MatrixMarket coordinate files (integer or pattern; general, symmetric or
+// skew-symmetric), assembled into CSR
+SparseMatrix parseMatrixMarket (const char * begin, const char * end) {
+	const char * lineEnd {std::find (begin, end, '\n')};
+	std::string banner {begin, lineEnd};
+	std::transform (std::begin (banner), std::end (banner), std::begin (banner), ::tolower);
+	std::istringstream header {banner};
+	std::string object, format, field, symmetry;
+	header >> object >> object >> format >> field >> symmetry;
+	if (object != "matrix" || format != "coordinate" || (field != "integer" && field != "pattern"))
+		throw std::runtime_error ("only integer or pattern coordinate MatrixMarket files are supported");
+	if (symmetry != "general" && symmetry != "symmetric" && symmetry != "skew-symmetric")
+		throw std::runtime_error ("unsupported MatrixMarket symmetry: " + symmetry);
+	const bool pattern {field == "pattern"};
+	const bool mirrored {symmetry != "general"};
+	const ValueType sign {symmetry == "skew-symmetric" ? -1 : 1};
+
+	while (lineEnd < end && (*begin == '%' || blankLine (begin, end))) {
+		begin = lineEnd + 1;
+		lineEnd = std::find (begin, end, '\n');
+	}
+	ValueType size[3];
+	const char * p {begin};
+	for (auto & dimension : size)
+		if (!(p = parseInteger (skipSeparators (p, lineEnd), dimension)))
+			throw std::runtime_error ("missing size line");
+	begin = std::min (end, lineEnd + 1);
+
+	// Triplets parsed per chunk, then counted and scattered into rows
+	struct Entry {
+		std::uint32_t row, col;
+		ValueType value;
+	};
+	const std::vector <const char *> bounds {lineChunks (begin, end, 4 * THREADS)};
+	const std::uint32_t chunks = bounds.size() - 1;
+	std::vector <std::vector <Entry>> entries (chunks);
+	forEachChunk (chunks, [&] (std::uint32_t chunk) {
+		for (const char * line {bounds[chunk]}; line < bounds[chunk + 1]; line = std::find (line, bounds[chunk + 1], '\n') + 1) {
+			if (blankLine (line, bounds[chunk + 1]) || *line == '%')
+				continue;
+			ValueType row, col, value {1};
+			const char * q {parseInteger (skipSeparators (line, end), row)};
+			q = q ? parseInteger (skipSeparators (q, end), col) : nullptr;
+			q = q && !pattern ? parseInteger (skipSeparators (q, end), value) : q;
+			if (!q || row < 1 || row > size[0] || col < 1 || col > size[1])
+				throw std::runtime_error ("bad entry: " + std::string {line, std::find (line, end, '\n')});
+			entries[chunk].push_back (Entry {static_cast <std::uint32_t> (row - 1), static_cast <std::uint32_t> (col - 1), value});
+			if (mirrored && row != col)
+				entries[chunk].push_back (Entry {static_cast <std::uint32_t> (col - 1), static_cast <std::uint32_t> (row - 1), sign * value});
+		}
+	});
+
+	SparseMatrix sparse {static_cast <std::uint32_t> (size[0]), static_cast <std::uint32_t> (size[1]), {}, {}, {}};
+	sparse.rowStart.assign (sparse.rows + 1, 0);
+	for (const auto & chunk : entries)
+		for (const auto & entry : chunk)
+			++sparse.rowStart[entry.row + 1];
+	std::partial_sum (std::begin (sparse.rowStart), std::end (sparse.rowStart), std::begin (sparse.rowStart));
+	sparse.columns.resize (sparse.rowStart.back());
+	sparse.values.resize (sparse.rowStart.back());
+	std::vector <std::uint32_t> next (std::begin (sparse.rowStart), std::end (sparse.rowStart) - 1);
+	for (const auto & chunk : entries)
+		for (const auto & entry : chunk) {
+			sparse.columns[next[entry.row]] = entry.col;
+			sparse.values[next[entry.row]++] = entry.value;
+		}
+	return sparse;
+}
+
+void loadMatrix (const std::string & path, Matrix2x2 & M) {
+	const std::vector <char> text {readPadded (path)};
+	const char * begin {text.data()}, * end {text.data() + text.size() - 8};
+	const bool matrixMarket {std::string {begin, std::min <std::size_t> (end - begin, 14)} == "%%MatrixMarket"};
+
+	auto startTime = std::chrono::high_resolution_clock::now();
+	std::ostringstream details;
+	try {
+		if (matrixMarket) {
+			const SparseMatrix sparse {parseMatrixMarket (begin, end)};
+			M.resize (boost::extents[sparse.rows][sparse.cols]);
+			std::fill_n (M.data(), M.num_elements(), 0);
+			for (std::uint32_t row{0}; row < sparse.rows; ++row)
+				for (std::uint32_t e{sparse.rowStart[row]}; e < sparse.rowStart[row + 1]; ++e)
+					M[row][sparse.columns[e]] += sparse.values[e];
+			details << ", " << sparse.values.size() << " nonzeros";
+		} else {
+			parseCSV (begin, end, M);
+		}
+	} catch (std::runtime_error & ex) {
+		throw std::runtime_error ("could not parse " + path + ": " + ex.what());
+	}
+	auto stopTime = std::chrono::high_resolution_clock::now();
+
+	const double seconds {std::chrono::duration <double> (stopTime - startTime).count()};
+	details << ") at " << std::fixed << std::setprecision (1) << (end - begin) / 1e6 / std::max (seconds, 1e-9) << " MB/s";
+	std::cout << "Parsed " << path << " (" << M.shape()[0] << "x" << M.shape()[1] << details.str() << std::endl;
+}
+
+// ********** BIT-PACKED STORAGE ********** //
+
+// Packs M with the narrowest power-of-two code width covering its value range
+BitPackedMatrix bitPack (const Matrix2x2 & M) {
+	const auto range = std::minmax_element (M.data(), M.data() + M.num_elements());
+	const std::uint64_t span {static_cast <std::uint64_t> (static_cast <std::int64_t> (*range.second) - *range.first)};
+	std::uint32_t bits {1};
+	while (bits < 32 && (span >> bits) != 0)
+		bits *= 2;
+
+	BitPackedMatrix packed;
+	packed.rows = M.shape()[0];
+	packed.cols = M.shape()[1];
+	packed.bits = bits;
+	packed.offset = *range.first;
+	const std::uint32_t perWord {64 / bits};
+	packed.wordsPerRow = (packed.cols + perWord - 1) / perWord;
+	packed.words.assign (std::size_t {packed.rows} * packed.wordsPerRow, 0);
+	for (std::uint32_t i{0}; i < packed.rows; ++i)
+		for (std::uint32_t j{0}; j < packed.cols; ++j) {
+			const std::uint64_t code {static_cast <std::uint32_t> (M[i][j] - packed.offset)};
+			packed.words[std::size_t {i} * packed.wordsPerRow + j / perWord] |= code << (j % perWord * bits);
+		}
+	return packed;
+}
+
+template <std::uint32_t Bits>
+void unpackCodes (const std::uint64_t * __restrict__ words, std::uint32_t lo, std::uint32_t hi, ValueType offset, ValueType * __restrict__ out) {
+	constexpr std::uint32_t PER_WORD {64 / Bits};
+	constexpr std::uint64_t MASK {Bits == 64 ? ~0ULL : (1ULL << Bits) - 1};
+	for (std::uint32_t e{lo}; e < hi; ++e)
+		out[e - lo] = offset + static_cast <ValueType> ((words[e / PER_WORD] >> (e % PER_WORD * Bits)) & MASK);
+}
+
+// Decompresses columns [lo, hi) of a row
+void unpackRow (const BitPackedMatrix & M, std::uint32_t row, std::uint32_t lo, std::uint32_t hi, ValueType * out) {
+	const std::uint64_t * words {M.words.data() + std::size_t {row} * M.wordsPerRow};
+	switch (M.bits) {
+	case 1: unpackCodes <1> (words, lo, hi, M.offset, out); break;
+	case 2: unpackCodes <2> (words, lo, hi, M.offset, out); break;
+	case 4: unpackCodes <4> (words, lo, hi, M.offset, out); break;
+	case 8: unpackCodes <8> (words, lo, hi, M.offset, out); break;
+	case 16: unpackCodes <16> (words, lo, hi, M.offset, out); break;
+	default: unpackCodes <32> (words, lo, hi, M.offset, out); break;
+	}
+}
+
+// Bit-packed copies of A and B, packed once per size outside the timed region
+const std::pair <BitPackedMatrix, BitPackedMatrix> & bitPackedOperands (const Matrix2x2 & A, const Matrix2x2 & B, const std::uint32_t N) {
+	static std::map <std::uint32_t, std::pair <BitPackedMatrix, BitPackedMatrix>> operands;
+	auto found = operands.find (N);
+	if (found == std::end (operands))
+		found = operands.emplace (N, std::make_pair (bitPack (A), bitPack (B))).first;
+	return found->second;
+}
+
+template <bool Packed>
+std::uint64_t multiplyPanels (const Matrix2x2 & A, const Matrix2x2 & B, Matrix2x2 & C, const std::uint32_t N) {
+	const BitPackedMatrix * packedA {nullptr}, * packedB {nullptr};
+	if (Packed) {
+		packedA = &bitPackedOperands (A, B, N).first;
+		packedB = &bitPackedOperands (A, B, N).second;
+	}
+	const std::uint32_t KC {std::max <std::uint32_t> (1, std::min <std::uint32_t> (N, PACK_PANEL_BYTES / (N * sizeof (ValueType))))};
+	std::vector <ValueType> panel (std::size_t {KC} * N), row (KC);
+
+	auto startTime = std::chrono::high_resolution_clock::now();
+	for (std::uint32_t k0{0}; k0 < N; k0 += KC) {
+		const std::uint32_t kc {std::min (KC, N - k0)};
+		for (std::uint32_t k{0}; k < kc; ++k)
+			if (Packed)
+				unpackRow (*packedB, k0 + k, 0, N, panel.data() + std::size_t {k} * N);
+			else
+				std::copy (B[k0 + k].begin(), B[k0 + k].end(), panel.data() + std::size_t {k} * N);
+		for (std::uint32_t i{0}; i < N; ++i) {
+			if (Packed)
+				unpackRow (*packedA, i, k0, k0 + kc, row.data());
+			else
+				std::copy (A[i].begin() + k0, A[i].begin() + k0 + kc, row.data());
+			multiplyBlock (row.data(), kc, panel.data(), N, C[i].origin(), N, 1, kc, N);
+		}
+	}
+	auto stopTime = std::chrono::high_resolution_clock::now();
+
+	const double bytes {Packed ? 8.0 * (packedA->words.size() + packedB->words.size()) : 2.0 * sizeof (ValueType) * N * N};
+	reportStat ("OPERAND STORAGE (KB):", bytes / 1024);
+	reportStat ("BITS PER VALUE:", Packed ? (packedA->bits + packedB->bits) / 2.0 : 8.0 * sizeof (ValueType));
+	return std::chrono::duration_cast <std::chrono::microseconds> (stopTime - startTime).count();
+}
+
+// ********** LOW-BIT KERNELS ********** //
+
+// Operands of the quantized kernels, with k padded to a multiple of four by
+// zero columns of A and zero rows of B
+struct LowBitOperands {
+	std::uint32_t K;
+	std::vector <std::int8_t> A8, B8;
+	std::vector <std::uint8_t> A4;			// N x K / 2, k even in the low nibble
+	std::vector <std::int8_t> sparseValues;		// N x K / 2, two per group of four
+	std::vector <std::uint8_t> sparseIndex;		// N x K / 4, 2-bit index of each value
+};
+
+std::int8_t clampTo (ValueType value, ValueType lo, ValueType hi) {
+	return static_cast <std::int8_t> (std::min (hi, std::max (lo, value)));
+}
+
+const LowBitOperands & lowBitOperands (const Matrix2x2 & A, const Matrix2x2 & B, const std::uint32_t N) {
+	static std::map <std::uint32_t, LowBitOperands> operands;
+	auto found = operands.find (N);
+	if (found != std::end (operands))
+		return found->second;
+
+	LowBitOperands & result = operands[N];
+	const std::uint32_t K {(N + 3) / 4 * 4};
+	result.K = K;
+	result.A8.assign (std::size_t {N} * K, 0);
+	result.B8.assign (std::size_t {K} * N, 0);
+	result.A4.assign (std::size_t {N} * K / 2, 0);
+	result.sparseValues.assign (std::size_t {N} * K / 2, 0);
+	result.sparseIndex.assign (std::size_t {N} * K / 4, 0);
+	for (std::uint32_t i{0}; i < N; ++i)
+		for (std::uint32_t k{0}; k < N; ++k) {
+			result.A8[std::size_t {i} * K + k] = clampTo (A[i][k], -128, 127);
+			result.B8[std::size_t {k} * N + i] = clampTo (B[k][i], -128, 127);
+			result.A4[(std::size_t {i} * K + k) / 2] |= (clampTo (A[i][k], -8, 7) & 0xF) << (k % 2 * 4);
+		}
+
+	// Keep the two largest magnitudes of every four, earlier ones on ties
+	for (std::uint32_t i{0}; i < N; ++i)
+		for (std::uint32_t g{0}; g < K / 4; ++g) {
+			const std::int8_t * group {result.A8.data() + std::size_t {i} * K + 4 * g};
+			std::uint32_t order[4] {0, 1, 2, 3};
+			std::stable_sort (order, order + 4, [group] (std::uint32_t x, std::uint32_t y) {
+				return std::abs (group[x]) > std::abs (group[y]);
+			});
+			std::sort (order, order + 2);
+			const std::size_t slot {std::size_t {i} * K / 4 + g};
+			result.sparseValues[2 * slot] = group[order[0]];
+			result.sparseValues[2 * slot + 1] = group[order[1]];
+			result.sparseIndex[slot] = order[0] | (order[1] << 2);
+		}
+	return result;
+}
+
+// c[0, N) += a0 * b0[0, N) + a1 * b1[0, N): the AVX2 path interleaves the two
+// int8 rows and multiplies column pairs with one 16-bit multiply-add
+template <bool Simd>
+void pairUpdate (std::int32_t * __restrict__ c, const std::int8_t * __restrict__ b0, const std::int8_t * __restrict__ b1,
+	std::int16_t a0, std::int16_t a1, const std::uint32_t N) {
+	std::uint32_t j {0};
+#ifdef __AVX2__
+	if (Simd) {
+		const __m256i a {_mm256_set1_epi32 (static_cast <std::uint16_t> (a0) | static_cast <std::uint32_t> (static_cast <std::uint16_t> (a1)) << 16)};
+		for (; j + 16 <= N; j += 16) {
+			const __m128i x0 {_mm_loadu_si128 (reinterpret_cast <const __m128i *> (b0 + j))};
+			const __m128i x1 {_mm_loadu_si128 (reinterpret_cast <const __m128i *> (b1 + j))};
+			const __m256i lo {_mm256_madd_epi16 (_mm256_cvtepi8_epi16 (_mm_unpacklo_epi8 (x0, x1)), a)};
+			const __m256i hi {_mm256_madd_epi16 (_mm256_cvtepi8_epi16 (_mm_unpackhi_epi8 (x0, x1)), a)};
+			__m256i * out {reinterpret_cast <__m256i *> (c + j)};
+			_mm256_storeu_si256 (out, _mm256_add_epi32 (_mm256_loadu_si256 (out), lo));
+			_mm256_storeu_si256 (out + 1, _mm256_add_epi32 (_mm256_loadu_si256 (out + 1), hi));
+		}
+	}
+#endif
+	for (; j < N; ++j)
+		c[j] += a0 * b0[j] + a1 * b1[j];
+}
+
+// Runs rowUpdate (i, c) for every row of C into an int32 row, then adds the row to C
+template <typename RowUpdate>
+std::uint64_t runLowBit (Matrix2x2 & C, const std::uint32_t N, RowUpdate rowUpdate) {
+	std::vector <std::int32_t> row (N);
+	auto startTime = std::chrono::high_resolution_clock::now();
+	for (std::uint32_t i{0}; i < N; ++i) {
+		std::fill (std::begin (row), std::end (row), 0);
+		rowUpdate (i, row.data());
+		std::transform (std::begin (row), std::end (row), C[i].begin(), C[i].begin(), std::plus <ValueType> {});
+	}
+	auto stopTime = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration_cast <std::chrono::microseconds> (stopTime - startTime).count();
+}
+
+template <bool Simd>
+void int8Row (const LowBitOperands & op, std::uint32_t i, std::int32_t * c, const std::uint32_t N) {
+	const std::int8_t * a {op.A8.data() + std::size_t {i} * op.K};
+	for (std::uint32_t k{0}; k < op.K; k += 2)
+		pairUpdate <Simd> (c, op.B8.data() + std::size_t {k} * N, op.B8.data() + std::size_t {k + 1} * N, a[k], a[k + 1], N);
+}
+
+// Reports the speedup over the best of three runs of the AVX2 dense int8
+// kernel, measured once per size
+void reportLowBit (const LowBitOperands & op, const std::uint32_t N, const std::uint64_t time) {
+	static std::map <std::uint32_t, std::uint64_t> baselines;
+	if (!baselines.count (N)) {
+		Matrix2x2 C {boost::extents[N][N]};
+		std::uint64_t best {std::numeric_limits <std::uint64_t>::max()};
+		for (std::uint32_t run{0}; run < 3; ++run)
+			best = std::min (best, runLowBit (C, N, [&] (std::uint32_t i, std::int32_t * c) { int8Row <true> (op, i, c, N); }));
+		baselines[N] = best;
+	}
+	reportStat ("SPEEDUP OVER INT8:", static_cast <double> (baselines[N]) / std::max <std::uint64_t> (time, 1));
+}
+
+template <bool Simd>
+std::uint64_t multiplyInt8 (const Matrix2x2 & A, const Matrix2x2 & B, Matrix2x2 & C, const std::uint32_t N) {
+	const LowBitOperands & op = lowBitOperands (A, B, N);
+	const std::uint64_t time {runLowBit (C, N, [&] (std::uint32_t i, std::int32_t * c) { int8Row <Simd> (op, i, c, N); })};
+	reportLowBit (op, N, time);
+	return time;
+}
+
+template <bool Simd>
+std::uint64_t multiplyInt4 (const Matrix2x2 & A, const Matrix2x2 & B, Matrix2x2 & C, const std::uint32_t N) {
+	const LowBitOperands & op = lowBitOperands (A, B, N);
+	const std::uint64_t time {runLowBit (C, N, [&] (std::uint32_t i, std::int32_t * c) {
+		const std::uint8_t * a {op.A4.data() + std::size_t {i} * op.K / 2};
+		for (std::uint32_t k{0}; k < op.K; k += 2) {
+			// Sign-extend both nibbles by shifting them to the top of a byte
+			const std::uint8_t pair {a[k / 2]};
+			const std::int16_t a0 {static_cast <std::int16_t> (static_cast <std::int8_t> (pair << 4) >> 4)};
+			const std::int16_t a1 {static_cast <std::int16_t> (static_cast <std::int8_t> (pair) >> 4)};
+			pairUpdate <Simd> (c, op.B8.data() + std::size_t {k} * N, op.B8.data() + std::size_t {k + 1} * N, a0, a1, N);
+		}
+	})};
+	reportLowBit (op, N, time);
+	return time;
+}
+
+template <bool Simd>
+std::uint64_t multiplySparse24 (const Matrix2x2 & A, const Matrix2x2 & B, Matrix2x2 & C, const std::uint32_t N) {
+	const LowBitOperands & op = lowBitOperands (A, B, N);
+	const std::uint64_t time {runLowBit (C, N, [&] (std::uint32_t i, std::int32_t * c) {
+		const std::size_t first {std::size_t {i} * op.K / 4};
+		for (std::uint32_t g{0}; g < op.K / 4; ++g) {
+			const std::uint8_t index {op.sparseIndex[first + g]};
+			const std::int8_t * values {op.sparseValues.data() + 2 * (first + g)};
+			pairUpdate <Simd> (c, op.B8.data() + std::size_t {4 * g + (index & 3)} * N, op.B8.data() + std::size_t {4 * g + (index >> 2)} * N,
+				values[0], values[1], N);
+		}
+	})};
+	reportLowBit (op, N, time);
+	return time;
+}
+
+// ********** FIXED-POINT KERNELS ********** //
+
+template <typename Q, Rounding R>
+typename Q::Acc roundProduct (typename Q::Product product) {
+	if (Q::ROUNDED == 0)
+		return product;
+	const std::uint32_t shift {Q::ROUNDED ? Q::ROUNDED : 1};
+	const typename Q::Product half {typename Q::Product {1} << (shift - 1)};
+	const typename Q::Product floor {product >> shift};
+	const typename Q::Product remainder {product & (2 * half - 1)};
+	return R == Rounding::TRUNCATE ? floor
+		: R == Rounding::HALF_UP ? (product + half) >> shift
+		: floor + (remainder > half || (remainder == half && (floor & 1)));
+}
+
+template <typename Q>
+typename Q::Output fixedOutput (typename Q::Acc acc, std::uint64_t & saturated) {
+	const typename Q::Acc lo {std::numeric_limits <typename Q::Output>::min()}, hi {std::numeric_limits <typename Q::Output>::max()};
+	acc *= typename Q::Acc {1} << Q::WIDEN;
+	if (WRAP || (acc >= lo && acc <= hi))
+		return static_cast <typename Q::Output> (acc);
+	++saturated;
+	return acc < lo ? lo : hi;
+}
+
+// Symmetric operands (no most negative value) within 1 / sqrt (N) of zero, so
+// no rounded product overflows and sums of N products mostly stay in range
+template <typename Q>
+const std::pair <std::vector <typename Q::Input>, std::vector <typename Q::Input>> & fixedOperands (const std::uint32_t N) {
+	static std::map <std::uint32_t, std::pair <std::vector <typename Q::Input>, std::vector <typename Q::Input>>> operands;
+	auto found = operands.find (N);
+	if (found != std::end (operands))
+		return found->second;
+
+	EngineType eng {SEED + 6};
+	const typename Q::Product hi {static_cast <typename Q::Product> (std::numeric_limits <typename Q::Input>::max() / std::sqrt (N))};
+	std::uniform_int_distribution <typename Q::Product> dist {-hi, hi};
+	auto & result = operands[N];
+	for (auto * operand : { &result.first, &result.second }) {
+		operand->resize (std::size_t {N} * N);
+		for (auto & value : *operand)
+			value = static_cast <typename Q::Input> (dist (eng));
+	}
+	return result;
+}
+
+// Scalar ijk reference of the rounded, saturated product
+template <typename Q, Rounding R>
+const std::vector <typename Q::Output> & fixedReference (const std::uint32_t N) {
+	static std::map <std::uint32_t, std::vector <typename Q::Output>> references;
+	auto found = references.find (N);
+	if (found != std::end (references))
+		return found->second;
+
+	const auto & operands = fixedOperands <Q> (N);
+	std::vector <typename Q::Output> & result = references[N];
+	result.resize (std::size_t {N} * N);
+	std::uint64_t saturated {0};
+	for (std::uint32_t i{0}; i < N; ++i)
+		for (std::uint32_t j{0}; j < N; ++j) {
+			typename Q::Acc acc {0};
+			for (std::uint32_t k{0}; k < N; ++k)
+				acc += roundProduct <Q, R> (typename Q::Product {operands.first[std::size_t {i} * N + k]} * operands.second[std::size_t {k} * N + j]);
+			result[std::size_t {i} * N + j] = fixedOutput <Q> (acc, saturated);
+		}
+	return result;
+}
+
+// c[0, N) += round (a * b[0, N))
+template <typename Q, Rounding R>
+struct FixedRow {
+	static void update (typename Q::Acc * __restrict__ c, typename Q::Input a, const typename Q::Input * __restrict__ b, const std::uint32_t N) {
+		for (std::uint32_t j{0}; j < N; ++j)
+			c[j] += roundProduct <Q, R> (typename Q::Product {a} * b[j]);
+	}
+};
+
+// Q15 products are exact in 32 bits, so they are formed eight at a time and
+// widened into the 64-bit accumulators whatever the rounding
+template <Rounding R>
+struct FixedRow <Q15, R> {
+	static void update (std::int64_t * __restrict__ c, std::int16_t a, const std::int16_t * __restrict__ b, const std::uint32_t N) {
+		std::uint32_t j {0};
+#ifdef __AVX2__
+		const __m256i broadcast {_mm256_set1_epi32 (a)};
+		for (; j + 8 <= N; j += 8) {
+			const __m256i product {_mm256_mullo_epi32 (broadcast, _mm256_cvtepi16_epi32 (_mm_loadu_si128 (reinterpret_cast <const __m128i *> (b + j))))};
+			__m256i * out {reinterpret_cast <__m256i *> (c + j)};
+			_mm256_storeu_si256 (out, _mm256_add_epi64 (_mm256_loadu_si256 (out), _mm256_cvtepi32_epi64 (_mm256_castsi256_si128 (product))));
+			_mm256_storeu_si256 (out + 1, _mm256_add_epi64 (_mm256_loadu_si256 (out + 1), _mm256_cvtepi32_epi64 (_mm256_extracti128_si256 (product, 1))));
+		}
+#endif
+		for (; j < N; ++j)
+			c[j] += std::int32_t {a} * b[j];
+	}
+};
+
+#define TO_STR(X) #X
+
+#define _(X) \
+	std::get <getIndex <char, Char <0> {TO_STR (X)}, L1, L2, L3> (0)> (std::tie (i, j, k))
+
+template <char L1, char L2, char L3, typename Q, Rounding R>
+void fixedKernel (const typename Q::Input * A, const typename Q::Input * B, typename Q::Acc * C, const std::uint32_t N) {
+	// j innermost (ikj, kij): whole rows of B and C at a time
+	if (L3 == 'j') {
+		for (std::uint32_t x{0}; x < N; ++x)
+			for (std::uint32_t y{0}; y < N; ++y) {
+				const std::uint32_t i {L1 == 'i' ? x : y}, k {L1 == 'i' ? y : x};
+				FixedRow <Q, R>::update (C + std::size_t {i} * N, A[std::size_t {i} * N + k], B + std::size_t {k} * N, N);
+			}
+		return;
+	}
+	for (std::uint32_t i{0}; i < N; ++i)
+		for (std::uint32_t j{0}; j < N; ++j)
+			for (std::uint32_t k{0}; k < N; ++k)
+				C[std::size_t {_(i)} * N + _(j)] += roundProduct <Q, R> (typename Q::Product {A[std::size_t {_(i)} * N + _(k)]} * B[std::size_t {_(k)} * N + _(j)]);
+}
+
+#undef TO_STR
+#undef _
+
+template <char L1, char L2, char L3, typename Q, Rounding R>
+std::uint64_t multiplyFixedRounding (Matrix2x2 & C, const std::uint32_t N) {
+	const auto & operands = fixedOperands <Q> (N);
+	const std::vector <typename Q::Output> & reference = fixedReference <Q, R> (N);
+	std::vector <typename Q::Acc> acc (std::size_t {N} * N);
+	std::uint64_t saturated {0}, mismatches {0};
+
+	auto startTime = std::chrono::high_resolution_clock::now();
+	fixedKernel <L1, L2, L3, Q, R> (operands.first.data(), operands.second.data(), acc.data(), N);
+	std::vector <typename Q::Output> result (acc.size());
+	for (std::size_t e{0}; e < acc.size(); ++e)
+		result[e] = fixedOutput <Q> (acc[e], saturated);
+	auto stopTime = std::chrono::high_resolution_clock::now();
+
+	for (std::size_t e{0}; e < result.size(); ++e) {
+		mismatches += result[e] != reference[e];
+		C.data()[e] += result[e];
+	}
+	reportStat ("SATURATED (%):", 100.0 * saturated / result.size());
+	reportStat ("MISMATCHES VS REFERENCE:", mismatches);
+	return std::chrono::duration_cast <std::chrono::microseconds> (stopTime - startTime).count();
+}
+
+template <char L1, char L2, char L3, typename Q>
+std::uint64_t multiplyFixed (const Matrix2x2 &, const Matrix2x2 &, Matrix2x2 & C, const std::uint32_t N) {
+	switch (ROUNDINGS.at (ROUNDING)) {
+	case Rounding::TRUNCATE: return multiplyFixedRounding <L1, L2, L3, Q, Rounding::TRUNCATE> (C, N);
+	case Rounding::HALF_UP: return multiplyFixedRounding <L1, L2, L3, Q, Rounding::HALF_UP> (C, N);
+	default: return multiplyFixedRounding <L1, L2, L3, Q, Rounding::CONVERGENT> (C, N);
+	}
+}
+
+// ********** BATCHED TINY MATRICES ********** //
+
+// Contiguous batch: matrix m occupies [m D^2, (m + 1) D^2), row-major. The
+// interleaved batch holds groups of BATCH_LANES matrices with element (i, j)
+// of every matrix in the group side by side, so lane l of a register is matrix l.
+std::vector <ValueType> toInterleaved (const std::vector <ValueType> & plain, const std::uint32_t count, const std::uint32_t D) {
+	const std::uint32_t groups {(count + BATCH_LANES - 1) / BATCH_LANES};
+	std::vector <ValueType> interleaved (std::size_t {groups} * D * D * BATCH_LANES);
+	for (std::uint32_t m{0}; m < count; ++m)
+		for (std::uint32_t e{0}; e < D * D; ++e)
+			interleaved[(std::size_t {m / BATCH_LANES} * D * D + e) * BATCH_LANES + m % BATCH_LANES] = plain[std::size_t {m} * D * D + e];
+	return interleaved;
+}
+
+std::vector <ValueType> fromInterleaved (const std::vector <ValueType> & interleaved, const std::uint32_t count, const std::uint32_t D) {
+	std::vector <ValueType> plain (std::size_t {count} * D * D);
+	for (std::uint32_t m{0}; m < count; ++m)
+		for (std::uint32_t e{0}; e < D * D; ++e)
+			plain[std::size_t {m} * D * D + e] = interleaved[(std::size_t {m / BATCH_LANES} * D * D + e) * BATCH_LANES + m % BATCH_LANES];
+	return plain;
+}
+
+template <std::uint32_t D>
+void batchPlain (const ValueType * A, const ValueType * B, ValueType * C, const std::uint32_t count) {
+	for (std::uint32_t m{0}; m < count; ++m, A += D * D, B += D * D, C += D * D)
+		for (std::uint32_t i{0}; i < D; ++i)
+			for (std::uint32_t k{0}; k < D; ++k)
+				for (std::uint32_t j{0}; j < D; ++j)
+					C[i * D + j] += A[i * D + k] * B[k * D + j];
+}
+
+// Every statement works on BATCH_LANES matrices at once
+template <std::uint32_t D>
+void batchInterleaved (const ValueType * A, const ValueType * B, ValueType * C, const std::uint32_t count) {
+	const std::uint32_t groups {(count + BATCH_LANES - 1) / BATCH_LANES};
+	const std::uint32_t STRIDE {D * D * BATCH_LANES};
+	for (std::uint32_t g{0}; g < groups; ++g, A += STRIDE, B += STRIDE, C += STRIDE)
+		for (std::uint32_t i{0}; i < D; ++i)
+			for (std::uint32_t j{0}; j < D; ++j) {
+				ValueType acc[BATCH_LANES] {};
+				for (std::uint32_t k{0}; k < D; ++k) {
+					const ValueType * __restrict__ a {A + (i * D + k) * BATCH_LANES};
+					const ValueType * __restrict__ b {B + (k * D + j) * BATCH_LANES};
+					for (std::uint32_t l{0}; l < BATCH_LANES; ++l)
+						acc[l] += a[l] * b[l];
+				}
+				ValueType * __restrict__ c {C + (i * D + j) * BATCH_LANES};
+				for (std::uint32_t l{0}; l < BATCH_LANES; ++l)
+					c[l] += acc[l];
+			}
+}
+
+template <bool Interleaved, std::uint32_t D>
+void batchKernel (const ValueType * A, const ValueType * B, ValueType * C, const std::uint32_t count) {
+	if (Interleaved)
+		batchInterleaved <D> (A, B, C, count);
+	else
+		batchPlain <D> (A, B, C, count);
+}
+
+template <bool Interleaved>
+std::uint64_t multiplyBatch (const Matrix2x2 & A, const Matrix2x2 & B, Matrix2x2 & C, const std::uint32_t N) {
+	using Clock = std::chrono::high_resolution_clock;
+	const std::uint32_t D {TINY_SIZE}, blocks {N / D}, count {blocks * blocks};
+
+	// The full D x D blocks of A and B as a contiguous batch
+	std::vector <ValueType> plainA (std::size_t {count} * D * D), plainB (plainA.size());
+	for (std::uint32_t m{0}; m < count; ++m)
+		for (std::uint32_t i{0}; i < D; ++i)
+			for (std::uint32_t j{0}; j < D; ++j) {
+				plainA[(std::size_t {m} * D + i) * D + j] = A[m / blocks * D + i][m % blocks * D + j];
+				plainB[(std::size_t {m} * D + i) * D + j] = B[m / blocks * D + i][m % blocks * D + j];
+			}
+
+	std::vector <ValueType> batchC (Interleaved ? (count + BATCH_LANES - 1) / BATCH_LANES * BATCH_LANES * D * D : plainA.size());
+	Clock::duration conversion {0};
+	auto convertTime = Clock::now();
+	std::vector <ValueType> interleavedA, interleavedB;
+	if (Interleaved) {
+		interleavedA = toInterleaved (plainA, count, D);
+		interleavedB = toInterleaved (plainB, count, D);
+	}
+	const std::vector <ValueType> & batchA {Interleaved ? interleavedA : plainA};
+	const std::vector <ValueType> & batchB {Interleaved ? interleavedB : plainB};
+	conversion += Clock::now() - convertTime;
+
+	auto startTime = Clock::now();
+	switch (D) {
+	case 2: batchKernel <Interleaved, 2> (batchA.data(), batchB.data(), batchC.data(), count); break;
+	case 3: batchKernel <Interleaved, 3> (batchA.data(), batchB.data(), batchC.data(), count); break;
+	case 4: batchKernel <Interleaved, 4> (batchA.data(), batchB.data(), batchC.data(), count); break;
+	case 5: batchKernel <Interleaved, 5> (batchA.data(), batchB.data(), batchC.data(), count); break;
+	case 6: batchKernel <Interleaved, 6> (batchA.data(), batchB.data(), batchC.data(), count); break;
+	case 7: batchKernel <Interleaved, 7> (batchA.data(), batchB.data(), batchC.data(), count); break;
+	default: batchKernel <Interleaved, 8> (batchA.data(), batchB.data(), batchC.data(), count); break;
+	}
+	auto stopTime = Clock::now();
+
+	convertTime = Clock::now();
+	if (Interleaved)
+		batchC = fromInterleaved (batchC, count, D);
+	conversion += Clock::now() - convertTime;
+
+	for (std::uint32_t m{0}; m < count; ++m)
+		for (std::uint32_t i{0}; i < D; ++i)
+			for (std::uint32_t j{0}; j < D; ++j)
+				C[m / blocks * D + i][m % blocks * D + j] += batchC[(std::size_t {m} * D + i) * D + j];
+
+	const double seconds {std::chrono::duration <double> (stopTime - startTime).count()};
+	reportStat ("MILLION MATRICES PER SECOND:", seconds > 0.0 ? count / seconds / 1e6 : 0.0);
+	reportStat ("LAYOUT CONVERSION (US):", std::chrono::duration <double, std::micro> (conversion).count());
+	return std::chrono::duration_cast <std::chrono::microseconds> (stopTime - startTime).count();
+}
+
+// ********** GROUPED BATCHES ********** //
+
+void groupedMultiply (const std::vector <GemmProblem> & problems) {
+	struct Tile {
+		std::uint32_t problem, lo, hi;
+	};
+	auto cost = [&] (std::uint32_t p) {
+		return std::uint64_t {problems[p].M} * problems[p].K * problems[p].N;
+	};
+
+	std::vector <std::uint32_t> order (problems.size());
+	std::iota (std::begin (order), std::end (order), 0);
+	std::sort (std::begin (order), std::end (order), [&] (std::uint32_t x, std::uint32_t y) { return cost (x) > cost (y); });
+	std::uint64_t total {0};
+	for (std::uint32_t p : order)
+		total += cost (p);
+
+	// Work items of about target cost, largest first so thieves take them early
+	ThreadPool & pool = threadPool();
+	const std::uint64_t target {std::max <std::uint64_t> (1, total / (4 * pool.size()))};
+	std::vector <std::vector <Tile>> items;
+	std::vector <Tile> bin;
+	std::uint64_t binCost {0};
+	for (std::uint32_t p : order) {
+		const GemmProblem & problem = problems[p];
+		if (cost (p) >= target) {
+			const std::uint32_t rows = std::max <std::uint64_t> (1, std::uint64_t {problem.M} * target / cost (p));
+			for (std::uint32_t lo{0}; lo < problem.M; lo += rows)
+				items.push_back ({ Tile {p, lo, std::min (problem.M, lo + rows)} });
+		} else if (cost (p) > 0) {
+			bin.push_back (Tile {p, 0, problem.M});
+			if ((binCost += cost (p)) >= target) {
+				items.push_back (std::move (bin));
+				bin.clear();
+				binCost = 0;
+			}
+		}
+	}
+	if (!bin.empty())
+		items.push_back (std::move (bin));
+
+	TaskGroup group {pool};
+	for (const auto & item : items)
+		group.run ([&problems, &item] {
+			for (const Tile & tile : item) {
+				const GemmProblem & p = problems[tile.problem];
+				multiplyBlock (p.A + std::size_t {tile.lo} * p.lda, p.lda, p.B, p.ldb, p.C + std::size_t {tile.lo} * p.ldc, p.ldc,
+					tile.hi - tile.lo, p.K, p.N);
+			}
+		});
+	group.wait();
+}
+
+// Dimensions in [1, N]: uniform, skewed toward small by a cubic, or mostly
+// small (up to N / 8) with one in ten of full size
+std::uint32_t batchDimension (EngineType & eng, const std::uint32_t N) {
+	std::uniform_real_distribution <double> unit {0.0, 1.0};
+	const double u {unit (eng)};
+	const double fraction {BATCH_SHAPES == "skewed" ? u * u * u
+		: BATCH_SHAPES == "bimodal" ? (unit (eng) < 0.1 ? 1.0 : u / 8)
+		: u};
+	return std::max <std::uint32_t> (1, std::min <std::uint32_t> (N, std::ceil (fraction * N)));
+}
+
+template <bool Grouped>
+std::uint64_t multiplyGrouped (const Matrix2x2 & A, const Matrix2x2 & B, Matrix2x2 & C, const std::uint32_t N) {
+	EngineType eng {SEED + 7};
+	std::vector <GemmProblem> problems (BATCH_COUNT);
+	std::vector <std::vector <ValueType>> results (BATCH_COUNT);
+	double operations {0.0};
+	for (std::uint32_t p{0}; p < BATCH_COUNT; ++p) {
+		const std::uint32_t M {batchDimension (eng, N)}, K {batchDimension (eng, N)}, cols {batchDimension (eng, N)};
+		results[p].assign (std::size_t {M} * cols, 0);
+		problems[p] = GemmProblem {M, K, cols, A.data() + std::size_t {N - M} * N, N, B.data() + (N - cols), N, results[p].data(), cols};
+		operations += 2.0 * M * K * cols;
+	}
+
+	auto startTime = std::chrono::high_resolution_clock::now();
+	if (Grouped)
+		groupedMultiply (problems);
+	else
+		for (const GemmProblem & p : problems)
+			parallelFor (p.M, [&p] (std::uint32_t lo, std::uint32_t hi) {
+				multiplyBlock (p.A + std::size_t {lo} * p.lda, p.lda, p.B, p.ldb, p.C + std::size_t {lo} * p.ldc, p.ldc, hi - lo, p.K, p.N);
+			});
+	auto stopTime = std::chrono::high_resolution_clock::now();
+
+	for (const GemmProblem & p : problems)
+		for (std::uint32_t i{0}; i < p.M; ++i)
+			for (std::uint32_t j{0}; j < p.N; ++j)
+				C[i][j] += p.C[std::size_t {i} * p.ldc + j];
+
+	const double seconds {std::chrono::duration <double> (stopTime - startTime).count()};
+	reportStat ("BATCH GOPS:", seconds > 0.0 ? operations / seconds / 1e9 : 0.0);
+	return std::chrono::duration_cast <std::chrono::microseconds> (stopTime - startTime).count();
+}
+
+// ********** SYMMETRIC RANK-K ********** //
+
+// C[i][j] += sum over k of A[i][k] * A[j][k] for rows [lo, hi), for j <= i
+// when Lower and every j otherwise, reading A^T a panel of rows at a time
+template <bool Lower>
+void syrkRows (const ValueType * A, const ValueType * AT, ValueType * C, const std::uint32_t N, const std::uint32_t lo, const std::uint32_t hi) {
+	const std::uint32_t KC {std::max <std::uint32_t> (1, std::min <std::uint32_t> (N, PACK_PANEL_BYTES / (N * sizeof (ValueType))))};
+	for (std::uint32_t k0{0}; k0 < N; k0 += KC)
+		for (std::uint32_t i{lo}; i < hi; ++i) {
+			const std::uint32_t cols {Lower ? i + 1 : N};
+			ValueType * __restrict__ c {C + std::size_t {i} * N};
+			for (std::uint32_t k{k0}; k < std::min (N, k0 + KC); ++k) {
+				const ValueType a {A[std::size_t {i} * N + k]};
+				const ValueType * __restrict__ b {AT + std::size_t {k} * N};
+				for (std::uint32_t j{0}; j < cols; ++j)
+					c[j] += a * b[j];
+			}
+		}
+}
+
+// Row blocks, longest (last) first; the work of row i grows with i when Lower
+template <bool Lower, bool Parallel>
+void syrkProduct (const ValueType * A, const ValueType * AT, ValueType * C, const std::uint32_t N) {
+	const std::uint32_t BLOCK {16}, blocks {(N + BLOCK - 1) / BLOCK};
+	auto body = [&] (std::uint32_t lo, std::uint32_t hi) {
+		for (std::uint32_t b{lo}; b < hi; ++b) {
+			const std::uint32_t block {blocks - 1 - b};
+			syrkRows <Lower> (A, AT, C, N, block * BLOCK, std::min (N, (block + 1) * BLOCK));
+		}
+	};
+	if (Parallel)
+		parallelFor (blocks, body, Schedule::DYNAMIC);
+	else
+		body (0, blocks);
+}
+
+// Best of three runs of the same kernel computing both triangles, once per size
+template <bool Parallel>
+std::uint64_t syrkBaseline (const ValueType * A, const ValueType * AT, const std::uint32_t N) {
+	static std::map <std::uint32_t, std::uint64_t> baselines;
+	if (!baselines.count (N)) {
+		std::vector <ValueType> C (std::size_t {N} * N);
+		std::uint64_t best {std::numeric_limits <std::uint64_t>::max()};
+		for (std::uint32_t run{0}; run < 3; ++run) {
+			std::fill (std::begin (C), std::end (C), 0);
+			auto startTime = std::chrono::high_resolution_clock::now();
+			syrkProduct <false, Parallel> (A, AT, C.data(), N);
+			auto stopTime = std::chrono::high_resolution_clock::now();
+			best = std::min <std::uint64_t> (best, std::chrono::duration_cast <std::chrono::microseconds> (stopTime - startTime).count());
+		}
+		baselines[N] = best;
+	}
+	return baselines[N];
+}
+
+template <bool Parallel>
+std::uint64_t multiplySyrk (const Matrix2x2 & A, const Matrix2x2 &, Matrix2x2 & C, const std::uint32_t N) {
+	// A^T is formed untimed, as for the baseline
+	std::vector <ValueType> AT (std::size_t {N} * N);
+	for (std::uint32_t i{0}; i < N; ++i)
+		for (std::uint32_t k{0}; k < N; ++k)
+			AT[std::size_t {k} * N + i] = A[i][k];
+	auto startTime = std::chrono::high_resolution_clock::now();
+	syrkProduct <true, Parallel> (A.data(), AT.data(), C.data(), N);
+	if (MIRROR)
+		for (std::uint32_t i{0}; i < N; ++i)
+			for (std::uint32_t j{0}; j < i; ++j)
+				C[j][i] = C[i][j];
+	auto stopTime = std::chrono::high_resolution_clock::now();
+
+	const std::uint64_t time = std::chrono::duration_cast <std::chrono::microseconds> (stopTime - startTime).count();
+	reportStat ("SAVING OVER GEMM:", static_cast <double> (syrkBaseline <Parallel> (A.data(), AT.data(), N)) / std::max <std::uint64_t> (time, 1));
+	return time;
+}
+
+// ********** FACTORIZATIONS ********** //
+
+#define TO_STR(X) #X
+
+#define _(X) \
+	std::get <getIndex <char, Char <0> {TO_STR (X)}, L1, L2, L3> (0)> (std::tie (i, j, k))
+
+// C (M x N) -= A (M x K) * B (K x N) on strided doubles in the L1 L2 L3 order
+template <char L1, char L2, char L3>
+void gemmSubtract (const double * __restrict__ A, std::uint32_t lda, const double * __restrict__ B, std::uint32_t ldb,
+	double * __restrict__ C, std::uint32_t ldc, std::uint32_t M, std::uint32_t K, std::uint32_t N) {
+	auto extent = [=] (char loop) {
+		return loop == 'i' ? M : loop == 'j' ? N : K;
+	};
+	const std::uint32_t E1 {extent (L1)}, E2 {extent (L2)}, E3 {extent (L3)};
+	for (std::uint32_t i{0}; i < E1; ++i)
+		for (std::uint32_t j{0}; j < E2; ++j)
+			for (std::uint32_t k{0}; k < E3; ++k)
+				C[std::size_t {_(i)} * ldc + _(j)] -= A[std::size_t {_(i)} * lda + _(k)] * B[std::size_t {_(k)} * ldb + _(j)];
+}
+
+#undef TO_STR
+#undef _
+
+// Operands: the fp64 A of the Ozaki traversals for LU, and F F^T + N I for
+// Cholesky, which is symmetric positive definite
+const std::vector <double> & factorOperand (const Matrix2x2 & A, const Matrix2x2 & B, const std::uint32_t N, bool cholesky) {
+	const std::vector <double> & F = floatOperands (A, B, N).A;
+	if (!cholesky)
+		return F;
+	static std::map <std::uint32_t, std::vector <double>> operands;
+	auto found = operands.find (N);
+	if (found != std::end (operands))
+		return found->second;
+	std::vector <double> & S = operands[N];
+	S.assign (std::size_t {N} * N, 0.0);
+	for (std::uint32_t i{0}; i < N; ++i)
+		for (std::uint32_t j{0}; j <= i; ++j) {
+			double sum {i == j ? static_cast <double> (N) : 0.0};
+			for (std::uint32_t k{0}; k < N; ++k)
+				sum += F[std::size_t {i} * N + k] * F[std::size_t {j} * N + k];
+			S[std::size_t {i} * N + j] = S[std::size_t {j} * N + i] = sum;
+		}
+	return S;
+}
+
+// Unblocked LU with partial pivoting of rows [r0, N) x columns [c0, c1),
+// swapping rows within those columns only; pivots[r] is the row swapped with r
+void luPanel (double * M, const std::uint32_t N, std::uint32_t r0, std::uint32_t c0, std::uint32_t c1, std::vector <std::uint32_t> & pivots) {
+	for (std::uint32_t c{c0}; c < c1; ++c) {
+		const std::uint32_t r {r0 + (c - c0)};
+		std::uint32_t pivot {r};
+		for (std::uint32_t i{r + 1}; i < N; ++i)
+			if (std::fabs (M[std::size_t {i} * N + c]) > std::fabs (M[std::size_t {pivot} * N + c]))
+				pivot = i;
+		pivots[r] = pivot;
+		if (pivot != r)
+			std::swap_ranges (M + std::size_t {r} * N + c0, M + std::size_t {r} * N + c1, M + std::size_t {pivot} * N + c0);
+		const double diagonal {M[std::size_t {r} * N + c]};
+		for (std::uint32_t i{r + 1}; i < N; ++i) {
+			double & l = M[std::size_t {i} * N + c];
+			l /= diagonal;
+			for (std::uint32_t j{c + 1}; j < c1; ++j)
+				M[std::size_t {i} * N + j] -= l * M[std::size_t {r} * N + j];
+		}
+	}
+}
+
+// Applies the pivots of rows [r0, r1) to columns [c0, c1)
+void applyPivots (double * M, const std::uint32_t N, std::uint32_t r0, std::uint32_t r1, std::uint32_t c0, std::uint32_t c1,
+	const std::vector <std::uint32_t> & pivots) {
+	for (std::uint32_t r{r0}; r < r1; ++r)
+		if (pivots[r] != r)
+			std::swap_ranges (M + std::size_t {r} * N + c0, M + std::size_t {r} * N + c1, M + std::size_t {pivots[r]} * N + c0);
+}
+
+// Unblocked Cholesky (lower) of the diagonal tile at [r0, r1)
+void choleskyTile (double * M, const std::uint32_t N, std::uint32_t r0, std::uint32_t r1) {
+	for (std::uint32_t j{r0}; j < r1; ++j) {
+		double diagonal {M[std::size_t {j} * N + j]};
+		for (std::uint32_t k{r0}; k < j; ++k)
+			diagonal -= M[std::size_t {j} * N + k] * M[std::size_t {j} * N + k];
+		diagonal = std::sqrt (diagonal);
+		M[std::size_t {j} * N + j] = diagonal;
+		for (std::uint32_t i{j + 1}; i < r1; ++i) {
+			double value {M[std::size_t {i} * N + j]};
+			for (std::uint32_t k{r0}; k < j; ++k)
+				value -= M[std::size_t {i} * N + k] * M[std::size_t {j} * N + k];
+			M[std::size_t {i} * N + j] = value / diagonal;
+		}
+	}
+}
+
+// Largest error of the reconstructed product (P^T L U or L L^T) relative to
+// the largest element of the original, as decimal digits
+double residualDigits (const std::vector <double> & original, const std::vector <double> & factors,
+	const std::vector <std::uint32_t> & pivots, const std::uint32_t N, bool cholesky) {
+	std::vector <double> product (std::size_t {N} * N, 0.0);
+	for (std::uint32_t i{0}; i < N; ++i)
+		for (std::uint32_t k{0}; k <= i; ++k) {
+			const double l {k == i && !cholesky ? 1.0 : factors[std::size_t {i} * N + k]};
+			if (cholesky)
+				for (std::uint32_t j{k}; j <= i; ++j)
+					product[std::size_t {i} * N + j] += l * factors[std::size_t {j} * N + k];
+			else
+				for (std::uint32_t j{k}; j < N; ++j)
+					product[std::size_t {i} * N + j] += l * factors[std::size_t {k} * N + j];
+		}
+	std::vector <double> permuted (original);
+	if (!cholesky)
+		applyPivots (permuted.data(), N, 0, N, 0, N, pivots);
+	double error {0.0}, magnitude {0.0};
+	for (std::size_t e{0}; e < product.size(); ++e) {
+		const std::uint32_t i = e / N, j = e % N;
+		if (cholesky && j > i)
+			continue;
+		error = std::max (error, std::fabs (product[e] - permuted[e]));
+		magnitude = std::max (magnitude, std::fabs (permuted[e]));
+	}
+	return error > 0.0 ? -std::log10 (error / magnitude) : std::numeric_limits <double>::digits10 + 1;
+}
+
+template <char L1, char L2, char L3, bool Cholesky>
+std::uint64_t factorize (const Matrix2x2 & A, const Matrix2x2 & B, Matrix2x2 & C, const std::uint32_t N) {
+	const std::vector <double> & original = factorOperand (A, B, N, Cholesky);
+	std::vector <double> M (original);
+	std::vector <std::uint32_t> pivots (N);
+	const std::uint32_t NB {std::min (FACTOR_BLOCK, N)}, T {(N + NB - 1) / NB};
+	auto lo = [=] (std::uint32_t t) { return t * NB; };
+	auto hi = [=] (std::uint32_t t) { return std::min (N, (t + 1) * NB); };
+	double * data {M.data()};
+
+	// Transposed copies of the L tiles of Cholesky, read as B by the updates
+	std::vector <std::vector <double>> transposed (Cholesky ? std::size_t {T} * T : 0);
+
+	auto startTime = std::chrono::high_resolution_clock::now();
+	TaskGraph graph;
+	std::vector <std::uint32_t> writer (std::size_t {T} * T);
+	std::vector <bool> written (writer.size(), false);
+	auto after = [&] (std::vector <std::pair <std::uint32_t, std::uint32_t>> tiles) {
+		std::vector <std::uint32_t> dependencies;
+		for (const auto & tile : tiles)
+			if (written[tile.first * T + tile.second])
+				dependencies.push_back (writer[tile.first * T + tile.second]);
+		return dependencies;
+	};
+	auto wrote = [&] (std::uint32_t task, std::vector <std::pair <std::uint32_t, std::uint32_t>> tiles) {
+		for (const auto & tile : tiles) {
+			writer[tile.first * T + tile.second] = task;
+			written[tile.first * T + tile.second] = true;
+		}
+	};
+
+	for (std::uint32_t p{0}; p < T; ++p) {
+		if (Cholesky) {
+			const std::uint32_t diagonal {graph.add ([=] { choleskyTile (data, N, lo (p), hi (p)); }, after ({{p, p}}))};
+			wrote (diagonal, {{p, p}});
+
+			// L_ip = A_ip L_pp^-T, also stored transposed for the updates
+			std::vector <std::uint32_t> solves (T);
+			for (std::uint32_t i{p + 1}; i < T; ++i) {
+				std::vector <std::uint32_t> dependencies {after ({{i, p}})};
+				dependencies.push_back (diagonal);
+				solves[i] = graph.add ([=, &transposed] {
+					for (std::uint32_t r{lo (i)}; r < hi (i); ++r)
+						for (std::uint32_t c{lo (p)}; c < hi (p); ++c) {
+							double value {data[std::size_t {r} * N + c]};
+							for (std::uint32_t k{lo (p)}; k < c; ++k)
+								value -= data[std::size_t {r} * N + k] * data[std::size_t {c} * N + k];
+							data[std::size_t {r} * N + c] = value / data[std::size_t {c} * N + c];
+						}
+				}, dependencies);
+				wrote (solves[i], {{i, p}});
+			}
+			for (std::uint32_t j{p + 1}; j < T; ++j) {
+				// Transposed L_jp, built once per step and tile column
+				const std::uint32_t transpose {graph.add ([=, &transposed] {
+					std::vector <double> & tile = transposed[p * T + j];
+					tile.assign (std::size_t {NB} * NB, 0.0);
+					for (std::uint32_t r{lo (j)}; r < hi (j); ++r)
+						for (std::uint32_t c{lo (p)}; c < hi (p); ++c)
+							tile[std::size_t {c - lo (p)} * NB + (r - lo (j))] = data[std::size_t {r} * N + c];
+				}, {solves[j]})};
+				for (std::uint32_t i{j}; i < T; ++i) {
+					std::vector <std::uint32_t> dependencies {after ({{i, j}})};
+					dependencies.push_back (solves[i]);
+					dependencies.push_back (transpose);
+					const std::uint32_t update {graph.add ([=, &transposed] {
+						gemmSubtract <L1, L2, L3> (data + std::size_t {lo (i)} * N + lo (p), N, transposed[p * T + j].data(), NB,
+							data + std::size_t {lo (i)} * N + lo (j), N, hi (i) - lo (i), hi (p) - lo (p), hi (j) - lo (j));
+					}, dependencies)};
+					wrote (update, {{i, j}});
+				}
+			}
+		} else {
+			std::vector <std::pair <std::uint32_t, std::uint32_t>> column;
+			for (std::uint32_t i{p}; i < T; ++i)
+				column.emplace_back (i, p);
+			const std::uint32_t panel {graph.add ([=, &pivots] {
+				luPanel (data, N, lo (p), lo (p), hi (p), pivots);
+			}, after (column))};
+			wrote (panel, column);
+
+			for (std::uint32_t j{p + 1}; j < T; ++j) {
+				// Row swaps of the panel, then U_pj = L_pp^-1 A_pj
+				std::vector <std::pair <std::uint32_t, std::uint32_t>> tiles;
+				for (std::uint32_t i{p}; i < T; ++i)
+					tiles.emplace_back (i, j);
+				std::vector <std::uint32_t> dependencies {after (tiles)};
+				dependencies.push_back (panel);
+				const std::uint32_t solve {graph.add ([=, &pivots] {
+					applyPivots (data, N, lo (p), hi (p), lo (j), hi (j), pivots);
+					for (std::uint32_t r{lo (p)}; r < hi (p); ++r)
+						for (std::uint32_t k{lo (p)}; k < r; ++k) {
+							const double l {data[std::size_t {r} * N + k]};
+							for (std::uint32_t c{lo (j)}; c < hi (j); ++c)
+								data[std::size_t {r} * N + c] -= l * data[std::size_t {k} * N + c];
+						}
+				}, dependencies)};
+				wrote (solve, tiles);
+
+				for (std::uint32_t i{p + 1}; i < T; ++i) {
+					std::vector <std::uint32_t> updateDependencies {after ({{i, j}})};
+					updateDependencies.push_back (panel);
+					const std::uint32_t update {graph.add ([=] {
+						gemmSubtract <L1, L2, L3> (data + std::size_t {lo (i)} * N + lo (p), N, data + std::size_t {lo (p)} * N + lo (j), N,
+							data + std::size_t {lo (i)} * N + lo (j), N, hi (i) - lo (i), hi (p) - lo (p), hi (j) - lo (j));
+					}, updateDependencies)};
+					wrote (update, {{i, j}});
+				}
+			}
+		}
+	}
+	graph.run (threadPool());
+
+	// Row swaps of later panels reach the L columns left of them
+	if (!Cholesky)
+		for (std::uint32_t p{1}; p < T; ++p)
+			applyPivots (data, N, lo (p), hi (p), 0, lo (p), pivots);
+	auto stopTime = std::chrono::high_resolution_clock::now();
+
+	for (std::size_t e{0}; e < M.size(); ++e)
+		C.data()[e] += static_cast <ValueType> (std::llround (M[e]));
+
+	const double seconds {std::chrono::duration <double> (stopTime - startTime).count()};
+	const double flops {(Cholesky ? 1.0 : 2.0) / 3.0 * N * N * N};
+	reportStat ("GFLOP/S:", seconds > 0.0 ? flops / seconds / 1e9 : 0.0);
+	reportStat ("RESIDUAL DIGITS:", residualDigits (original, M, pivots, N, Cholesky));
+	return std::chrono::duration_cast <std::chrono::microseconds> (stopTime - startTime).count();
+}